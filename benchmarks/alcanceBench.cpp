@@ -0,0 +1,81 @@
+// Mede o indice de alcance de grafoNavegacao.h em um grafo de dependencias
+// (quase um DAG, com alguns ciclos): tempo de construcao, memoria, fracao das
+// consultas respondidas so pelos rotulos e tempo por consulta contra a busca
+// bidirecional sem indice.
+// Compilar: g++ -O2 -std=c++17 -pthread alcanceBench.cpp -o alcanceBench
+// Uso: ./alcanceBench [numVertices] [arestasPorVertice] [numConsultas]
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "../src/grafos/grafoNavegacao.h"
+
+using namespace std;
+
+/* Cada vertice depende de vertices posteriores, em geral proximos; uma
+ * pequena parte das arestas volta para tras e forma componentes fortes.
+ */
+GrafoListaAdj* construirDependencias(int numVertices, int arestasPorVertice, mt19937& gerador) {
+  GrafoListaAdj* grafo = new GrafoListaAdj();
+  for (int v = 0; v < numVertices; v++) grafo->inserirVertice("v" + to_string(v));
+
+  for (int v = 0; v < numVertices; v++) {
+    for (int k = 0; k < arestasPorVertice; k++) {
+      int salto = gerador() % 100 < 90 ? 1 + gerador() % 64 : 1 + gerador() % numVertices;
+      int u = gerador() % 100 < 2 ? v - salto : v + salto;
+      if (u >= 0 && u < numVertices) grafo->inserirArestaDirecionada("v" + to_string(v), "v" + to_string(u));
+    }
+  }
+  return grafo;
+}
+
+/* Executa haCaminho para cada par e retorna o tempo total em ms.
+ */
+double medir(GrafoListaAdj* grafo, const vector<pair<string, string>>& pares, int& alcancaveis) {
+  alcancaveis = 0;
+  auto inicio = chrono::steady_clock::now();
+  for (const pair<string, string>& par : pares) alcancaveis += grafo->haCaminho(par.first, par.second);
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+}
+
+int main(int argc, char** argv) {
+  int numVertices = argc > 1 ? atoi(argv[1]) : 200000;
+  int arestasPorVertice = argc > 2 ? atoi(argv[2]) : 3;
+  int numConsultas = argc > 3 ? atoi(argv[3]) : 100000;
+  mt19937 gerador(42);
+
+  GrafoListaAdj* grafo = construirDependencias(numVertices, arestasPorVertice, gerador);
+
+  vector<pair<string, string>> pares;
+  for (int k = 0; k < numConsultas; k++) {
+    pares.push_back(pair<string, string>("v" + to_string(gerador() % numVertices), "v" + to_string(gerador() % numVertices)));
+  }
+
+  // a busca sem indice eh lenta: mede so uma parte das consultas
+  vector<pair<string, string>> amostra(pares.begin(), pares.begin() + min(numConsultas, 1000));
+  int alcancaveisBusca;
+  double busca = medir(grafo, amostra, alcancaveisBusca);
+
+  grafo->ativarIndiceAlcance();
+  EstatisticasAlcance construcao = grafo->getEstatisticasAlcance();
+
+  int alcancaveisAmostra, alcancaveis;
+  medir(grafo, amostra, alcancaveisAmostra);
+  double indice = medir(grafo, pares, alcancaveis);
+  EstatisticasAlcance estatisticas = grafo->getEstatisticasAlcance();
+
+  printf("dependencias com %d vertices, %d arestas por vertice\n", numVertices, arestasPorVertice);
+  printf("  %-26s %10d\n", "componentes fortes", construcao.numComponentes);
+  printf("  %-26s %10d\n", "arestas do DAG", construcao.numArestasDAG);
+  printf("  %-26s %10.2f ms\n", "construcao do indice", construcao.msConstrucao);
+  printf("  %-26s %10.2f MB\n", "memoria do indice", construcao.bytes / 1048576.0);
+  printf("  %-26s %10.2f %%\n", "respondidas pelos rotulos",
+         100.0 * estatisticas.consultasPorRotulos / (estatisticas.consultasPorRotulos + estatisticas.consultasComBusca));
+  printf("  %-26s %10.2f us\n", "consulta sem indice", 1000.0 * busca / amostra.size());
+  printf("  %-26s %10.2f us  (%.1fx)\n", "consulta com indice", 1000.0 * indice / pares.size(),
+         (busca / amostra.size()) / (indice / pares.size()));
+  printf("  %-26s %10s\n", "mesmas respostas", alcancaveisAmostra == alcancaveisBusca ? "sim" : "NAO");
+
+  delete grafo;
+  return 0;
+}
@@ -0,0 +1,135 @@
+// Compara as variantes de BFS de grafoNavegacao.h em um grafo com hubs
+// (rede social) e em uma malha (diametro grande), incluindo a escalabilidade
+// da bfsParalela de 1 ate maxThreads threads, a bfsMultiplasOrigens
+// contra uma bfs por origem e a latencia de vizinhancaKHops.
+// Compilar: g++ -O2 -std=c++17 -pthread bfsBench.cpp -o bfsBench
+// Uso: ./bfsBench [verticesSocial] [ladoMalha] [maxThreads]
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "../src/grafos/grafoNavegacao.h"
+
+using namespace std;
+
+/* Grafo de Barabasi-Albert: cada novo vertice se liga a m vertices
+ * escolhidos com probabilidade proporcional ao grau, gerando hubs.
+ */
+GrafoListaAdj* construirSocial(int numVertices, int m, mt19937& gerador) {
+  GrafoListaAdj* grafo = new GrafoListaAdj();
+  for (int v = 0; v < numVertices; v++) grafo->inserirVertice("v" + to_string(v));
+
+  vector<int> extremidades;
+  for (int v = 1; v < numVertices; v++) {
+    for (int k = 0; k < m && k < v; k++) {
+      int u = extremidades.empty() ? 0 : extremidades[gerador() % extremidades.size()];
+      grafo->inserirArestaNaoDirecionada("v" + to_string(v), "v" + to_string(u));
+      extremidades.push_back(u);
+      extremidades.push_back(v);
+    }
+  }
+  return grafo;
+}
+
+GrafoListaAdj* construirMalha(int lado) {
+  GrafoListaAdj* grafo = new GrafoListaAdj();
+  for (int v = 0; v < lado * lado; v++) grafo->inserirVertice("v" + to_string(v));
+
+  for (int l = 0; l < lado; l++) {
+    for (int c = 0; c < lado; c++) {
+      int v = l * lado + c;
+      if (c + 1 < lado) grafo->inserirArestaNaoDirecionada("v" + to_string(v), "v" + to_string(v + 1));
+      if (l + 1 < lado) grafo->inserirArestaNaoDirecionada("v" + to_string(v), "v" + to_string(v + lado));
+    }
+  }
+  return grafo;
+}
+
+/* Executa a variante a partir de cada origem e retorna o tempo total em ms.
+ */
+template <typename Variante>
+double medir(GrafoListaAdj* grafo, const vector<string>& origens, Variante variante) {
+  auto inicio = chrono::steady_clock::now();
+  for (const string& origem : origens) free(variante(grafo, origem));
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+}
+
+void executar(const string& titulo, GrafoListaAdj* grafo, mt19937& gerador, int maxThreads) {
+  vector<string> origens;
+  for (int k = 0; k < 8; k++) origens.push_back(string(grafo->getRotulo(gerador() % grafo->getNumVertices())));
+
+  // a primeira chamada monta a adjacencia reversa; nao entra na medicao
+  free(grafo->bfsDirecaoOtimizada(origens[0]));
+
+  double base = medir(grafo, origens, [](GrafoListaAdj* g, const string& o) { return g->bfs(o); });
+  double otimizada = medir(grafo, origens, [](GrafoListaAdj* g, const string& o) { return g->bfsDirecaoOtimizada(o); });
+
+  printf("%s\n", titulo.c_str());
+  printf("  %-22s %10.2f ms\n", "bfs", base);
+  printf("  %-22s %10.2f ms  (%.2fx)\n", "bfsDirecaoOtimizada", otimizada, base / otimizada);
+
+  for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    double paralela = medir(grafo, origens, [=](GrafoListaAdj* g, const string& o) { return g->bfsParalela(o, numThreads); });
+    string nome = "bfsParalela " + to_string(numThreads) + "t";
+    printf("  %-22s %10.2f ms  (%.2fx)\n", nome.c_str(), paralela, base / paralela);
+  }
+
+  // distancias de 256 origens: 256 chamadas de bfs contra 4 lotes de MS-BFS
+  vector<string> muitasOrigens;
+  for (int k = 0; k < 256; k++) muitasOrigens.push_back(string(grafo->getRotulo(gerador() % grafo->getNumVertices())));
+
+  double umaPorVez = medir(grafo, muitasOrigens, [](GrafoListaAdj* g, const string& o) { return g->bfs(o); });
+
+  vector<int> matriz(muitasOrigens.size() * (size_t)grafo->getNumVertices());
+  auto inicio = chrono::steady_clock::now();
+  grafo->bfsMultiplasOrigens(muitasOrigens, matriz.data());
+  double multiplas = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+
+  printf("  %-22s %10.2f ms\n", "bfs x 256 origens", umaPorVez);
+  printf("  %-22s %10.2f ms  (%.2fx)\n", "bfsMultiplasOrigens", multiplas, umaPorVez / multiplas);
+
+  // latencia de "vertices a ate k arestas": bfs inteira + varredura contra vizinhancaKHops
+  EspacoBusca espaco;
+  for (int k = 1; k <= 3; k++) {
+    auto inicioBfs = chrono::steady_clock::now();
+    long long encontradosBfs = 0;
+    for (const string& origem : origens) {
+      int* distancias = grafo->bfs(origem);
+      for (int v = 0; v < grafo->getNumVertices(); v++) encontradosBfs += distancias[v] <= k;
+      free(distancias);
+    }
+    double porBfs = chrono::duration<double, milli>(chrono::steady_clock::now() - inicioBfs).count();
+
+    auto inicioKHops = chrono::steady_clock::now();
+    long long encontrados = 0;
+    for (const string& origem : muitasOrigens) encontrados += grafo->vizinhancaKHops(origem, k, espaco);
+    double porKHops = chrono::duration<double, milli>(chrono::steady_clock::now() - inicioKHops).count();
+
+    long long encontradosKHops = 0;
+    for (const string& origem : origens) encontradosKHops += grafo->vizinhancaKHops(origem, k, espaco);
+
+    double latenciaBfs = 1000.0 * porBfs / origens.size();
+    double latenciaKHops = 1000.0 * porKHops / muitasOrigens.size();
+    string nome = "vizinhancaKHops k=" + to_string(k);
+    printf("  %-22s %10.2f us  (%.1fx, %lld vertices por consulta, mesmas respostas: %s)\n", nome.c_str(), latenciaKHops,
+           latenciaBfs / latenciaKHops, encontrados / (long long)muitasOrigens.size(),
+           encontradosKHops == encontradosBfs ? "sim" : "NAO");
+  }
+}
+
+int main(int argc, char** argv) {
+  int verticesSocial = argc > 1 ? atoi(argv[1]) : 200000;
+  int ladoMalha = argc > 2 ? atoi(argv[2]) : 400;
+  int maxThreads = argc > 3 ? atoi(argv[3]) : max(1u, thread::hardware_concurrency());
+  mt19937 gerador(42);
+
+  GrafoListaAdj* social = construirSocial(verticesSocial, 8, gerador);
+  executar("social com " + to_string(verticesSocial) + " vertices", social, gerador, maxThreads);
+  delete social;
+
+  GrafoListaAdj* malha = construirMalha(ladoMalha);
+  executar("malha " + to_string(ladoMalha) + "x" + to_string(ladoMalha), malha, gerador, maxThreads);
+  delete malha;
+
+  return 0;
+}
@@ -0,0 +1,63 @@
+// Mede colorirVertices de grafoNavegacao.h em um grafo com hubs (rede
+// social): cores usadas, rodadas de conflito e tempo para cada ordem de
+// prioridade, de 1 ate maxThreads threads.
+// Compilar: g++ -O2 -std=c++17 -pthread coloracaoBench.cpp -o coloracaoBench
+// Uso: ./coloracaoBench [numVertices] [maxThreads]
+#include <random>
+#include <string>
+
+#include "../src/grafos/grafoNavegacao.h"
+
+using namespace std;
+
+/* Grafo de Barabasi-Albert: cada novo vertice se liga a m vertices
+ * escolhidos com probabilidade proporcional ao grau, gerando hubs.
+ */
+GrafoListaAdj* construirSocial(int numVertices, int m, mt19937& gerador) {
+  GrafoListaAdj* grafo = new GrafoListaAdj();
+  for (int v = 0; v < numVertices; v++) grafo->inserirVertice("v" + to_string(v));
+
+  vector<int> extremidades;
+  for (int v = 1; v < numVertices; v++) {
+    for (int k = 0; k < m && k < v; k++) {
+      int u = extremidades.empty() ? 0 : extremidades[gerador() % extremidades.size()];
+      grafo->inserirArestaNaoDirecionada("v" + to_string(v), "v" + to_string(u));
+      extremidades.push_back(u);
+      extremidades.push_back(v);
+    }
+  }
+  return grafo;
+}
+
+int main(int argc, char** argv) {
+  int numVertices = argc > 1 ? atoi(argv[1]) : 1000000;
+  int maxThreads = argc > 2 ? atoi(argv[2]) : max(1u, thread::hardware_concurrency());
+  mt19937 gerador(42);
+
+  GrafoListaAdj* grafo = construirSocial(numVertices, 8, gerador);
+  vector<int> cores(numVertices);
+
+  // a primeira chamada monta a adjacencia reversa; nao entra na medicao
+  grafo->colorirVertices(cores.data(), 1);
+
+  const char* nomes[] = {"natural", "maior grau", "menor ultimo"};
+  OrdemColoracao ordens[] = {ORDEM_NATURAL, ORDEM_MAIOR_GRAU, ORDEM_MENOR_ULTIMO};
+
+  printf("social com %d vertices\n", numVertices);
+  printf("  %-14s %8s %6s %7s %10s %12s\n", "ordem", "threads", "cores", "rodadas", "conflitos", "tempo");
+
+  for (int o = 0; o < 3; o++) {
+    double base = 0;
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+      EstatisticasColoracao estatisticas;
+      grafo->colorirVertices(cores.data(), numThreads, ordens[o], &estatisticas);
+      if (numThreads == 1) base = estatisticas.msExecucao;
+
+      printf("  %-14s %8d %6d %7d %10lld %9.2f ms  (%.2fx)\n", nomes[o], numThreads, estatisticas.numCores,
+             estatisticas.rodadas, estatisticas.conflitos, estatisticas.msExecucao, base / estatisticas.msExecucao);
+    }
+  }
+
+  delete grafo;
+  return 0;
+}
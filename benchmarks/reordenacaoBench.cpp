@@ -0,0 +1,169 @@
+// Compara bfs e dijkstra antes e depois de reordenar() em um grafo tipo
+// malha (rede de estradas) e em um grafo com hubs (rede social).
+// Compilar: g++ -O2 -std=c++17 reordenacaoBench.cpp -o reordenacaoBench
+// Uso: ./reordenacaoBench [ladoMalha] [verticesSocial]
+#include <string.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "../src/grafos/grafoMenorCaminho.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * Contador de cache misses do processador. Quando o kernel nao permite
+ * acesso aos contadores (ou fora do Linux), disponivel() retorna false
+ * e apenas o tempo eh reportado.
+ **/
+class ContadorCacheMiss {
+ private:
+  int fd;
+
+ public:
+  ContadorCacheMiss() : fd(-1) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~ContadorCacheMiss() {
+#ifdef __linux__
+    if (fd != -1) close(fd);
+#endif
+  }
+
+  bool disponivel() {
+    return fd != -1;
+  }
+
+  void iniciar() {
+#ifdef __linux__
+    if (fd == -1) return;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  long long parar() {
+    long long valor = 0;
+#ifdef __linux__
+    if (fd == -1) return 0;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd, &valor, sizeof(valor)) != sizeof(valor)) valor = 0;
+#endif
+    return valor;
+  }
+};
+
+/* Malha lado x lado com pesos aleatorios. Os vertices sao inseridos em
+ * ordem embaralhada para que a numeracao inicial nao tenha localidade.
+ */
+GrafoListaAdj* construirMalha(int lado, mt19937& gerador) {
+  GrafoListaAdj* grafo = new GrafoListaAdj();
+  vector<int> ordem(lado * lado);
+  for (int i = 0; i < ordem.size(); i++) ordem[i] = i;
+  shuffle(ordem.begin(), ordem.end(), gerador);
+
+  for (int v : ordem) grafo->inserirVertice("v" + to_string(v));
+
+  uniform_int_distribution<int> peso(1, 100);
+  for (int l = 0; l < lado; l++) {
+    for (int c = 0; c < lado; c++) {
+      int v = l * lado + c;
+      if (c + 1 < lado) grafo->inserirArestaNaoDirecionada("v" + to_string(v), "v" + to_string(v + 1), peso(gerador));
+      if (l + 1 < lado) grafo->inserirArestaNaoDirecionada("v" + to_string(v), "v" + to_string(v + lado), peso(gerador));
+    }
+  }
+  return grafo;
+}
+
+/* Grafo de Barabasi-Albert: cada novo vertice se liga a m vertices
+ * escolhidos com probabilidade proporcional ao grau, gerando hubs.
+ */
+GrafoListaAdj* construirSocial(int numVertices, int m, mt19937& gerador) {
+  GrafoListaAdj* grafo = new GrafoListaAdj();
+  vector<int> ordem(numVertices);
+  for (int i = 0; i < numVertices; i++) ordem[i] = i;
+  shuffle(ordem.begin(), ordem.end(), gerador);
+
+  for (int v : ordem) grafo->inserirVertice("v" + to_string(v));
+
+  vector<int> extremidades;
+  uniform_int_distribution<int> peso(1, 100);
+  for (int v = 1; v < numVertices; v++) {
+    for (int k = 0; k < m && k < v; k++) {
+      int u = extremidades.empty() ? 0 : extremidades[gerador() % extremidades.size()];
+      grafo->inserirArestaNaoDirecionada("v" + to_string(v), "v" + to_string(u), peso(gerador));
+      extremidades.push_back(u);
+      extremidades.push_back(v);
+    }
+  }
+  return grafo;
+}
+
+void medir(const string& nome, GrafoListaAdj* grafo, const vector<string>& origens, ContadorCacheMiss& contador) {
+  for (int algoritmo = 0; algoritmo < 2; algoritmo++) {
+    contador.iniciar();
+    auto inicio = chrono::steady_clock::now();
+
+    for (const string& origem : origens) free(algoritmo == 0 ? grafo->bfs(origem) : grafo->dijkstra(origem));
+
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+    long long misses = contador.parar();
+
+    printf("  %-10s %-9s %10.2f ms", nome.c_str(), algoritmo == 0 ? "bfs" : "dijkstra", ms);
+    if (contador.disponivel()) printf("  %12lld cache misses", misses);
+    printf("\n");
+  }
+}
+
+void executar(const string& titulo, GrafoListaAdj* (*construir)(mt19937&)) {
+  const char* nomes[] = {"original", "rcm", "grau", "bfs"};
+  EstrategiaReordenacao estrategias[] = {REORDENAR_RCM, REORDENAR_GRAU, REORDENAR_BFS};
+  ContadorCacheMiss contador;
+
+  printf("%s\n", titulo.c_str());
+  for (int i = 0; i < 4; i++) {
+    mt19937 gerador(42);
+    GrafoListaAdj* grafo = construir(gerador);
+
+    // as mesmas origens (por rotulo) em todas as variantes
+    vector<string> origens;
+    for (int k = 0; k < 8; k++) origens.push_back(grafo->getRotulo(gerador() % grafo->getNumVertices()));
+
+    if (i > 0) grafo->reordenar(estrategias[i - 1]);
+    medir(nomes[i], grafo, origens, contador);
+    delete grafo;
+  }
+}
+
+int ladoMalha = 300;
+int verticesSocial = 100000;
+
+int main(int argc, char** argv) {
+  if (argc > 1) ladoMalha = atoi(argv[1]);
+  if (argc > 2) verticesSocial = atoi(argv[2]);
+
+  executar("malha " + to_string(ladoMalha) + "x" + to_string(ladoMalha),
+           [](mt19937& gerador) { return construirMalha(ladoMalha, gerador); });
+  executar("social com " + to_string(verticesSocial) + " vertices",
+           [](mt19937& gerador) { return construirSocial(verticesSocial, 4, gerador); });
+
+  return 0;
+}
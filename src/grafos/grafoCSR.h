@@ -0,0 +1,852 @@
+#pragma once
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#define POS_INF 1000000000
+#define NEG_INF -1000000000
+
+/**
+ * Mapeia um arquivo inteiro em memoria somente-leitura.
+ * Em sistemas POSIX usamos mmap, de modo que o arquivo nao eh copiado
+ * para o processo: as paginas sao lidas sob demanda do page cache.
+ * No Windows (MinGW) fazemos a leitura completa do arquivo para um buffer.
+ **/
+class ArquivoMapeado {
+ private:
+  char* dados;
+  size_t tamanho;
+  bool mapeado;
+
+ public:
+  ArquivoMapeado() : dados(NULL), tamanho(0), mapeado(false) {}
+
+  ~ArquivoMapeado() {
+    fechar();
+  }
+
+  ArquivoMapeado(const ArquivoMapeado&) = delete;
+  ArquivoMapeado& operator=(const ArquivoMapeado&) = delete;
+
+  bool abrir(const string& caminho) {
+    fechar();
+#ifndef _WIN32
+    int fd = open(caminho.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+      close(fd);
+      return false;
+    }
+
+    tamanho = info.st_size;
+    if (tamanho > 0) {
+      void* p = mmap(NULL, tamanho, PROT_READ, MAP_SHARED, fd, 0);
+      if (p == MAP_FAILED) {
+        close(fd);
+        tamanho = 0;
+        return false;
+      }
+      dados = (char*)p;
+      mapeado = true;
+      madvise(p, tamanho, MADV_SEQUENTIAL);
+    }
+    close(fd);
+    return true;
+#else
+    FILE* arquivo = fopen(caminho.c_str(), "rb");
+    if (!arquivo) return false;
+
+    fseek(arquivo, 0, SEEK_END);
+    tamanho = ftell(arquivo);
+    fseek(arquivo, 0, SEEK_SET);
+
+    dados = (char*)malloc(tamanho > 0 ? tamanho : 1);
+    if (fread(dados, 1, tamanho, arquivo) != tamanho) {
+      fclose(arquivo);
+      fechar();
+      return false;
+    }
+    fclose(arquivo);
+    return true;
+#endif
+  }
+
+  void fechar() {
+    if (!dados) return;
+#ifndef _WIN32
+    if (mapeado) munmap(dados, tamanho);
+#endif
+    if (!mapeado) free(dados);
+    dados = NULL;
+    tamanho = 0;
+    mapeado = false;
+  }
+
+  const char* getDados() {
+    return dados;
+  }
+
+  size_t getTamanho() {
+    return tamanho;
+  }
+};
+
+/**
+ * Formato binario do GrafoCSR (versao 1). As secoes aparecem nesta ordem:
+ *   cabecalho            CabecalhoCSR
+ *   offsets              (numVertices + 1) x int64
+ *   offsetsRotulos       (numVertices + 1) x int64
+ *   destinos             numArestas x int32
+ *   pesos                numArestas x int32
+ *   rotulos              tamanhoRotulos bytes, concatenados e sem '\0'
+ * Os inteiros sao gravados na ordem de bytes da maquina (little-endian em x86),
+ * e as secoes de 8 bytes ficam alinhadas, de modo que o arquivo mapeado pode
+ * ser usado diretamente, sem copia.
+ **/
+#define CSR_MAGICA "GRAFOCSR"
+#define CSR_VERSAO 1
+
+class CabecalhoCSR {
+ public:
+  char magica[8];
+  uint32_t versao;
+  uint32_t reservado;
+  int64_t numVertices;
+  int64_t numArestas;
+  int64_t tamanhoRotulos;
+};
+
+/**
+ * Grafo somente-leitura no formato CSR (compressed sparse row).
+ * Os vizinhos do vertice v ficam em destinos[offsets[v]] ate
+ * destinos[offsets[v + 1] - 1], e o peso de cada aresta na mesma
+ * posicao do vetor pesos.
+ * Cada lista de vizinhos eh mantida ordenada pelo indice do destino,
+ * o que permite busca binaria em saoConectados.
+ * Os vetores podem pertencer ao proprio objeto (grafo montado em memoria)
+ * ou apontar para um arquivo binario mapeado (abrirBinario).
+ **/
+class GrafoCSR {
+ public:
+  class Aresta {
+   public:
+    int origem;
+    int destino;
+    int peso;
+
+    Aresta() {}
+    Aresta(int origem, int destino, int peso) : origem(origem), destino(destino), peso(peso) {}
+  };
+
+  // usado para ordenar as arestas por peso no Kruskal
+  friend bool operator<(const Aresta& a1, const Aresta& a2) {
+    return a1.peso < a2.peso;
+  }
+
+ private:
+  int qtdeVertices;
+  int64_t qtdeArestas;
+
+  const int64_t* offsets;
+  const int* destinos;
+  const int* pesos;
+
+  // o rotulo do vertice v eh bytesRotulos[offsetsRotulos[v] .. offsetsRotulos[v + 1] - 1]
+  const int64_t* offsetsRotulos;
+  const char* bytesRotulos;
+
+  // armazenamento usado quando o grafo eh montado em memoria
+  vector<int64_t> offsetsProprios;
+  vector<int> destinosProprios;
+  vector<int> pesosProprios;
+  vector<int64_t> offsetsRotulosProprios;
+  string bytesRotulosProprios;
+
+  // armazenamento usado quando o grafo vem de um arquivo binario
+  ArquivoMapeado arquivo;
+
+  // montado apenas na primeira busca por rotulo
+  unordered_map<string_view, int> indicesVertices;
+
+  GrafoCSR()
+      : qtdeVertices(0),
+        qtdeArestas(0),
+        offsets(NULL),
+        destinos(NULL),
+        pesos(NULL),
+        offsetsRotulos(NULL),
+        bytesRotulos(NULL) {}
+
+  // aresta lida do arquivo, com os indices locais do bloco que a leu
+  class ArestaLida {
+   public:
+    int origem;
+    int destino;
+    int peso;
+  };
+
+  // estado de cada thread durante o carregamento
+  class BlocoLeitura {
+   public:
+    const char* inicio;
+    const char* fim;
+    vector<string_view> rotulos;
+    unordered_map<string_view, int> indicesLocais;
+    vector<ArestaLida> arestas;
+    vector<int> indicesGlobais;
+
+    // alguma linha tinha um peso que nao eh um inteiro
+    bool pesoInvalido = false;
+  };
+
+  static bool ehEspaco(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+  }
+
+  static int internarLocal(BlocoLeitura& bloco, string_view rotulo) {
+    auto it = bloco.indicesLocais.find(rotulo);
+    if (it != bloco.indicesLocais.end()) return it->second;
+
+    int indice = bloco.rotulos.size();
+    bloco.indicesLocais.emplace(rotulo, indice);
+    bloco.rotulos.push_back(rotulo);
+    return indice;
+  }
+
+  /**
+   * Le as linhas "origem destino [peso]" do bloco.
+   * Linhas vazias e comentarios (iniciados por # ou %) sao ignorados,
+   * assim como linhas com menos de dois campos. Um peso que nao seja um
+   * inteiro marca o bloco como invalido e interrompe a leitura.
+   **/
+  static void lerBloco(BlocoLeitura& bloco) {
+    const char* p = bloco.inicio;
+
+    while (p < bloco.fim) {
+      const char* fimLinha = (const char*)memchr(p, '\n', bloco.fim - p);
+      if (!fimLinha) fimLinha = bloco.fim;
+
+      string_view campos[3];
+      int qtdeCampos = 0;
+      const char* c = p;
+
+      while (c < fimLinha && qtdeCampos < 3) {
+        while (c < fimLinha && ehEspaco(*c)) c++;
+        if (c == fimLinha) break;
+
+        const char* inicioCampo = c;
+        while (c < fimLinha && !ehEspaco(*c)) c++;
+        campos[qtdeCampos++] = string_view(inicioCampo, c - inicioCampo);
+      }
+
+      bool comentario = qtdeCampos > 0 && (campos[0][0] == '#' || campos[0][0] == '%');
+
+      if (qtdeCampos >= 2 && !comentario) {
+        ArestaLida aresta;
+        aresta.origem = internarLocal(bloco, campos[0]);
+        aresta.destino = internarLocal(bloco, campos[1]);
+        aresta.peso = 1;
+
+        if (qtdeCampos == 3) {
+          const char* fimPeso = campos[2].data() + campos[2].size();
+          from_chars_result lido = from_chars(campos[2].data(), fimPeso, aresta.peso);
+
+          if (lido.ec != errc() || lido.ptr != fimPeso) {
+            bloco.pesoInvalido = true;
+            return;
+          }
+        }
+
+        bloco.arestas.push_back(aresta);
+      }
+
+      p = fimLinha + 1;
+    }
+  }
+
+  /**
+   * Executa funcao(t) para t = 0 .. numThreads - 1, cada uma em uma thread.
+   **/
+  template <typename Funcao>
+  static void executarEmParalelo(int numThreads, Funcao funcao) {
+    if (numThreads <= 1) {
+      funcao(0);
+      return;
+    }
+
+    vector<thread> threads;
+    for (int t = 0; t < numThreads; t++) threads.emplace_back(funcao, t);
+    for (int t = 0; t < numThreads; t++) threads[t].join();
+  }
+
+  void adicionarRotulo(string_view rotulo) {
+    if (offsetsRotulosProprios.empty()) offsetsRotulosProprios.push_back(0);
+    bytesRotulosProprios.append(rotulo.data(), rotulo.size());
+    offsetsRotulosProprios.push_back(bytesRotulosProprios.size());
+  }
+
+  void usarArmazenamentoProprio() {
+    if (offsetsRotulosProprios.empty()) offsetsRotulosProprios.push_back(0);
+    if (offsetsProprios.empty()) offsetsProprios.push_back(0);
+
+    qtdeVertices = offsetsProprios.size() - 1;
+    qtdeArestas = offsetsProprios.back();
+    offsets = offsetsProprios.data();
+    destinos = destinosProprios.data();
+    pesos = pesosProprios.data();
+    offsetsRotulos = offsetsRotulosProprios.data();
+    bytesRotulos = bytesRotulosProprios.data();
+    indicesVertices.clear();
+  }
+
+  void ordenarVizinhos(int v, vector<pair<int, int>>& vizinhos) {
+    int64_t ini = offsetsProprios[v], fim = offsetsProprios[v + 1];
+
+    vizinhos.clear();
+    for (int64_t i = ini; i < fim; i++) vizinhos.push_back({destinosProprios[i], pesosProprios[i]});
+    sort(vizinhos.begin(), vizinhos.end());
+
+    for (int64_t i = ini; i < fim; i++) {
+      destinosProprios[i] = vizinhos[i - ini].first;
+      pesosProprios[i] = vizinhos[i - ini].second;
+    }
+  }
+
+  // a ordem de preenchimento pode depender das threads, entao ordenamos
+  // cada lista de vizinhos para que o resultado seja deterministico
+  void ordenarListas(int numThreads) {
+    int numVertices = offsetsProprios.size() - 1;
+
+    executarEmParalelo(numThreads, [&](int t) {
+      vector<pair<int, int>> vizinhos;
+      for (int v = t; v < numVertices; v += numThreads) ordenarVizinhos(v, vizinhos);
+    });
+  }
+
+  // Grupo do union-find usado no Kruskal
+  class Grupo {
+   public:
+    int pai;
+    int tamanho;
+  };
+
+  int encontrarRaiz(Grupo* grupos, int i) {
+    while (grupos[i].pai != i) {
+      grupos[i].pai = grupos[grupos[i].pai].pai;
+      i = grupos[i].pai;
+    }
+    return i;
+  }
+
+  void unirGrupos(Grupo* grupos, int a, int b) {
+    int raizA = encontrarRaiz(grupos, a);
+    int raizB = encontrarRaiz(grupos, b);
+
+    if (raizA == raizB) return;
+
+    if (grupos[raizA].tamanho >= grupos[raizB].tamanho) {
+      grupos[raizB].pai = raizA;
+      grupos[raizA].tamanho += grupos[raizB].tamanho;
+    } else {
+      grupos[raizA].pai = raizB;
+      grupos[raizB].tamanho += grupos[raizA].tamanho;
+    }
+  }
+
+ public:
+  GrafoCSR(const GrafoCSR&) = delete;
+  GrafoCSR& operator=(const GrafoCSR&) = delete;
+
+  /**
+   * Carrega um arquivo texto de arestas (formato SNAP/TSV: "origem destino [peso]").
+   * O arquivo eh mapeado em memoria e dividido em numThreads blocos, alinhados
+   * ao inicio de uma linha, que sao lidos em paralelo.
+   * Os rotulos recebem indices na ordem em que aparecem no arquivo.
+   * A lista de adjacencias eh montada em duas passadas: primeiro contamos o
+   * grau de cada vertice, depois preenchemos as posicoes ja reservadas.
+   * Se naoDirecionado for true, cada linha gera as duas arestas.
+   * Retorna NULL se o arquivo nao puder ser aberto ou se algum peso nao
+   * for um inteiro.
+   **/
+  static GrafoCSR* carregarListaArestas(const string& caminho, bool naoDirecionado, int numThreads) {
+    ArquivoMapeado arquivo;
+    if (!arquivo.abrir(caminho)) return NULL;
+
+    const char* dados = arquivo.getDados();
+    size_t tamanho = arquivo.getTamanho();
+
+    if (numThreads < 1) numThreads = 1;
+    if ((size_t)numThreads > tamanho / 4096 + 1) numThreads = tamanho / 4096 + 1;
+
+    vector<BlocoLeitura> blocos(numThreads);
+    const char* inicio = dados;
+    for (int t = 0; t < numThreads; t++) {
+      const char* fim = dados + tamanho * (t + 1) / numThreads;
+      while (fim < dados + tamanho && fim > inicio && fim[-1] != '\n') fim++;
+      if (fim < inicio) fim = inicio;
+
+      blocos[t].inicio = inicio;
+      blocos[t].fim = fim;
+      inicio = fim;
+    }
+
+    executarEmParalelo(numThreads, [&](int t) { lerBloco(blocos[t]); });
+
+    for (int t = 0; t < numThreads; t++) {
+      if (blocos[t].pesoInvalido) return NULL;
+    }
+
+    // os rotulos sao unificados em ordem de bloco, o que reproduz a
+    // ordem de primeira aparicao no arquivo
+    GrafoCSR* grafo = new GrafoCSR();
+    unordered_map<string_view, int> indicesGlobais;
+    for (int t = 0; t < numThreads; t++) {
+      BlocoLeitura& bloco = blocos[t];
+      bloco.indicesGlobais.resize(bloco.rotulos.size());
+
+      for (int i = 0; i < bloco.rotulos.size(); i++) {
+        auto it = indicesGlobais.find(bloco.rotulos[i]);
+
+        if (it == indicesGlobais.end()) {
+          bloco.indicesGlobais[i] = indicesGlobais.size();
+          indicesGlobais.emplace(bloco.rotulos[i], indicesGlobais.size());
+          grafo->adicionarRotulo(bloco.rotulos[i]);
+        } else {
+          bloco.indicesGlobais[i] = it->second;
+        }
+      }
+      bloco.indicesLocais.clear();
+      bloco.rotulos.clear();
+    }
+
+    int numVertices = indicesGlobais.size();
+    atomic<int64_t>* cursores = new atomic<int64_t>[numVertices + 1];
+    for (int v = 0; v <= numVertices; v++) cursores[v].store(0, memory_order_relaxed);
+
+    // passada 1: contar o grau de saida de cada vertice
+    executarEmParalelo(numThreads, [&](int t) {
+      BlocoLeitura& bloco = blocos[t];
+      for (ArestaLida& aresta : bloco.arestas) {
+        aresta.origem = bloco.indicesGlobais[aresta.origem];
+        aresta.destino = bloco.indicesGlobais[aresta.destino];
+
+        cursores[aresta.origem].fetch_add(1, memory_order_relaxed);
+        if (naoDirecionado) cursores[aresta.destino].fetch_add(1, memory_order_relaxed);
+      }
+    });
+
+    vector<int64_t>& offsets = grafo->offsetsProprios;
+    offsets.resize(numVertices + 1);
+    offsets[0] = 0;
+    for (int v = 0; v < numVertices; v++) {
+      offsets[v + 1] = offsets[v] + cursores[v].load(memory_order_relaxed);
+      cursores[v].store(offsets[v], memory_order_relaxed);
+    }
+
+    vector<int>& destinos = grafo->destinosProprios;
+    vector<int>& pesos = grafo->pesosProprios;
+    destinos.resize(offsets[numVertices]);
+    pesos.resize(offsets[numVertices]);
+
+    // passada 2: cada aresta ocupa a proxima posicao livre da sua origem
+    executarEmParalelo(numThreads, [&](int t) {
+      for (ArestaLida& aresta : blocos[t].arestas) {
+        int64_t pos = cursores[aresta.origem].fetch_add(1, memory_order_relaxed);
+        destinos[pos] = aresta.destino;
+        pesos[pos] = aresta.peso;
+
+        if (naoDirecionado) {
+          pos = cursores[aresta.destino].fetch_add(1, memory_order_relaxed);
+          destinos[pos] = aresta.origem;
+          pesos[pos] = aresta.peso;
+        }
+      }
+      vector<ArestaLida>().swap(blocos[t].arestas);
+    });
+
+    delete[] cursores;
+
+    grafo->ordenarListas(numThreads);
+    grafo->usarArmazenamentoProprio();
+
+    return grafo;
+  }
+
+  static GrafoCSR* carregarListaArestas(const string& caminho, bool naoDirecionado) {
+    return carregarListaArestas(caminho, naoDirecionado, thread::hardware_concurrency());
+  }
+
+  /**
+   * Monta o grafo em memoria a partir dos rotulos e de uma lista de
+   * arestas direcionadas (origem e destino sao indices em rotulos).
+   **/
+  static GrafoCSR* construir(const vector<string>& rotulos, const vector<Aresta>& arestas) {
+    GrafoCSR* grafo = new GrafoCSR();
+    int numVertices = rotulos.size();
+
+    for (int v = 0; v < numVertices; v++) grafo->adicionarRotulo(rotulos[v]);
+
+    vector<int64_t>& offsets = grafo->offsetsProprios;
+    offsets.assign(numVertices + 1, 0);
+    for (const Aresta& aresta : arestas) offsets[aresta.origem + 1]++;
+    for (int v = 0; v < numVertices; v++) offsets[v + 1] += offsets[v];
+
+    vector<int64_t> cursores(offsets.begin(), offsets.end() - 1);
+    grafo->destinosProprios.resize(arestas.size());
+    grafo->pesosProprios.resize(arestas.size());
+
+    for (const Aresta& aresta : arestas) {
+      int64_t pos = cursores[aresta.origem]++;
+      grafo->destinosProprios[pos] = aresta.destino;
+      grafo->pesosProprios[pos] = aresta.peso;
+    }
+
+    grafo->ordenarListas(1);
+    grafo->usarArmazenamentoProprio();
+
+    return grafo;
+  }
+
+  /**
+   * Grava o grafo no formato binario descrito em CabecalhoCSR.
+   * Retorna false se o arquivo nao puder ser escrito.
+   **/
+  bool salvarBinario(const string& caminho) {
+    FILE* saida = fopen(caminho.c_str(), "wb");
+    if (!saida) return false;
+
+    CabecalhoCSR cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, CSR_MAGICA, sizeof(cabecalho.magica));
+    cabecalho.versao = CSR_VERSAO;
+    cabecalho.numVertices = qtdeVertices;
+    cabecalho.numArestas = qtdeArestas;
+    cabecalho.tamanhoRotulos = offsetsRotulos[qtdeVertices];
+
+    bool ok = fwrite(&cabecalho, sizeof(cabecalho), 1, saida) == 1;
+    ok = ok && fwrite(offsets, sizeof(int64_t), qtdeVertices + 1, saida) == (size_t)qtdeVertices + 1;
+    ok = ok && fwrite(offsetsRotulos, sizeof(int64_t), qtdeVertices + 1, saida) == (size_t)qtdeVertices + 1;
+    ok = ok && fwrite(destinos, sizeof(int), qtdeArestas, saida) == (size_t)qtdeArestas;
+    ok = ok && fwrite(pesos, sizeof(int), qtdeArestas, saida) == (size_t)qtdeArestas;
+    ok = ok && fwrite(bytesRotulos, 1, cabecalho.tamanhoRotulos, saida) == (size_t)cabecalho.tamanhoRotulos;
+
+    return fclose(saida) == 0 && ok;
+  }
+
+  /**
+   * Abre um arquivo gravado por salvarBinario sem copiar seus vetores:
+   * o grafo retornado aponta diretamente para as paginas mapeadas,
+   * que sao compartilhadas com outros processos que abrirem o mesmo arquivo.
+   * O cabecalho e as pontas dos offsets sao sempre conferidos e, por
+   * padrao, o arquivo inteiro tambem passa por validar(), o que custa
+   * O(V + E) mas impede que um arquivo truncado ou corrompido faca as
+   * buscas lerem fora dos vetores. Arquivos confiaveis (gravados pelo
+   * proprio processo, por exemplo) podem ser abertos com validarTudo
+   * false, pulando essa passada.
+   * Retorna NULL se o arquivo nao existir ou nao estiver no formato esperado.
+   **/
+  static GrafoCSR* abrirBinario(const string& caminho, bool validarTudo = true) {
+    GrafoCSR* grafo = new GrafoCSR();
+    ArquivoMapeado& arquivo = grafo->arquivo;
+
+    if (!arquivo.abrir(caminho) || arquivo.getTamanho() < sizeof(CabecalhoCSR)) {
+      delete grafo;
+      return NULL;
+    }
+
+    const char* dados = arquivo.getDados();
+    const CabecalhoCSR* cabecalho = (const CabecalhoCSR*)dados;
+    int64_t v = cabecalho->numVertices, e = cabecalho->numArestas, r = cabecalho->tamanhoRotulos;
+
+    // os campos do cabecalho nao sao confiaveis: cada secao eh comparada com
+    // o que sobra do arquivo antes de ser descontada, entao nada transborda
+    uint64_t restante = arquivo.getTamanho() - sizeof(CabecalhoCSR);
+    bool valido = memcmp(cabecalho->magica, CSR_MAGICA, sizeof(cabecalho->magica)) == 0 &&
+                  cabecalho->versao == CSR_VERSAO && v >= 0 && v < INT_MAX && e >= 0 && r >= 0 &&
+                  (uint64_t)v + 1 <= restante / (2 * sizeof(int64_t));
+    if (valido) {
+      restante -= 2 * ((uint64_t)v + 1) * sizeof(int64_t);
+      valido = (uint64_t)e <= restante / (2 * sizeof(int)) && restante - 2 * (uint64_t)e * sizeof(int) == (uint64_t)r;
+    }
+
+    if (!valido) {
+      delete grafo;
+      return NULL;
+    }
+
+    const char* p = dados + sizeof(CabecalhoCSR);
+    grafo->qtdeVertices = v;
+    grafo->qtdeArestas = e;
+    grafo->offsets = (const int64_t*)p;
+    p += (v + 1) * sizeof(int64_t);
+    grafo->offsetsRotulos = (const int64_t*)p;
+    p += (v + 1) * sizeof(int64_t);
+    grafo->destinos = (const int*)p;
+    p += e * sizeof(int);
+    grafo->pesos = (const int*)p;
+    p += e * sizeof(int);
+    grafo->bytesRotulos = p;
+
+    valido = grafo->offsets[0] == 0 && grafo->offsets[v] == e && grafo->offsetsRotulos[0] == 0 &&
+             grafo->offsetsRotulos[v] == r;
+    if (!valido || (validarTudo && !grafo->validar())) {
+      delete grafo;
+      return NULL;
+    }
+
+    return grafo;
+  }
+
+  /**
+   * Confere a estrutura inteira em O(V + E): offsets comecando em 0,
+   * crescentes e terminando em numArestas, e listas de vizinhos ordenadas
+   * com destinos entre 0 e numVertices - 1. Um grafo que passa aqui pode
+   * ser percorrido sem acessos fora dos vetores.
+   **/
+  bool validar() {
+    if (offsets[0] != 0 || offsets[qtdeVertices] != qtdeArestas || offsetsRotulos[0] != 0) return false;
+
+    for (int v = 0; v < qtdeVertices; v++) {
+      if (offsets[v] > offsets[v + 1] || offsetsRotulos[v] > offsetsRotulos[v + 1]) return false;
+
+      for (int64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+        if (destinos[i] < 0 || destinos[i] >= qtdeVertices) return false;
+        if (i > offsets[v] && destinos[i - 1] > destinos[i]) return false;
+      }
+    }
+    return true;
+  }
+
+  int obterIndiceVertice(string_view rotuloVertice) {
+    if (indicesVertices.empty() && qtdeVertices > 0) {
+      indicesVertices.reserve(qtdeVertices);
+      for (int v = 0; v < qtdeVertices; v++) indicesVertices.emplace(rotulo(v), v);
+    }
+
+    auto it = indicesVertices.find(rotuloVertice);
+    if (it == indicesVertices.end()) return -1;
+    return it->second;
+  }
+
+  int numVertices() {
+    return qtdeVertices;
+  }
+
+  int64_t numArestas() {
+    return qtdeArestas;
+  }
+
+  int grau(int indiceVertice) {
+    return offsets[indiceVertice + 1] - offsets[indiceVertice];
+  }
+
+  string_view rotulo(int indiceVertice) {
+    return string_view(bytesRotulos + offsetsRotulos[indiceVertice],
+                       offsetsRotulos[indiceVertice + 1] - offsetsRotulos[indiceVertice]);
+  }
+
+  const int64_t* getOffsets() {
+    return offsets;
+  }
+
+  const int* getDestinos() {
+    return destinos;
+  }
+
+  const int* getPesos() {
+    return pesos;
+  }
+
+  /**
+   * Como as listas de vizinhos estao ordenadas, usamos busca binaria.
+   **/
+  bool saoConectados(string_view rotuloVOrigem, string_view rotuloVDestino) {
+    int origem = obterIndiceVertice(rotuloVOrigem);
+    int destino = obterIndiceVertice(rotuloVDestino);
+
+    if (origem == -1 || destino == -1) return false;
+
+    return binary_search(destinos + offsets[origem], destinos + offsets[origem + 1], destino);
+  }
+
+  /**
+   * Mesma semantica do bfs de GrafoListaAdj: vertices inalcancaveis
+   * ficam com distancia 0.
+   * Retorna NULL se o vertice de origem nao existir.
+   **/
+  int* bfs(string_view rotuloVOrigem) {
+    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
+    if (indiceRotuloOrigem == -1) return NULL;
+
+    int* distancias = (int*)malloc(sizeof(int) * qtdeVertices);
+    vector<bool> indicesVerticesVisitados(qtdeVertices, false);
+
+    for (int i = 0; i < qtdeVertices; i++) distancias[i] = 0;
+
+    queue<int> fila;
+
+    indicesVerticesVisitados[indiceRotuloOrigem] = true;
+    fila.push(indiceRotuloOrigem);
+
+    while (!fila.empty()) {
+      int indiceVerticeFrenteFila = fila.front();
+      fila.pop();
+
+      for (int64_t i = offsets[indiceVerticeFrenteFila]; i < offsets[indiceVerticeFrenteFila + 1]; i++) {
+        int indiceVerticeVizinho = destinos[i];
+
+        if (!indicesVerticesVisitados[indiceVerticeVizinho]) {
+          indicesVerticesVisitados[indiceVerticeVizinho] = true;
+          distancias[indiceVerticeVizinho] = distancias[indiceVerticeFrenteFila] + 1;
+          fila.push(indiceVerticeVizinho);
+        }
+      }
+    }
+
+    return distancias;
+  }
+
+  /**
+   * Mesma semantica do bellmanFord de GrafoListaAdj: POS_INF para vertices
+   * inalcancaveis e NEG_INF para vertices afetados por ciclos negativos.
+   * Retorna NULL se o vertice de origem nao existir.
+   **/
+  int* bellmanFord(string_view rotuloVOrigem) {
+    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
+    if (indiceRotuloOrigem == -1) return NULL;
+
+    int* distancias = (int*)malloc(sizeof(int) * qtdeVertices);
+
+    for (int i = 0; i < qtdeVertices; i++) distancias[i] = POS_INF;
+
+    distancias[indiceRotuloOrigem] = 0;
+
+    for (int i = 0; i < qtdeVertices; i++) {
+      bool mudou = false;
+
+      for (int j = 0; j < qtdeVertices; j++) {
+        if (distancias[j] == POS_INF) continue;
+
+        for (int64_t k = offsets[j]; k < offsets[j + 1]; k++) {
+          if (distancias[j] + pesos[k] < distancias[destinos[k]]) {
+            distancias[destinos[k]] = distancias[j] + pesos[k];
+            mudou = true;
+          }
+        }
+      }
+      if (!mudou) break;
+    }
+
+    for (int j = 0; j < qtdeVertices; j++) {
+      if (distancias[j] == POS_INF) continue;
+
+      for (int64_t k = offsets[j]; k < offsets[j + 1]; k++) {
+        if (distancias[j] + pesos[k] < distancias[destinos[k]]) distancias[destinos[k]] = NEG_INF;
+      }
+    }
+
+    return distancias;
+  }
+
+  /**
+   * Mesma semantica do dijkstra de GrafoListaAdj: POS_INF para vertices
+   * inalcancaveis. Os pesos nao podem ser negativos.
+   * Retorna NULL se o vertice de origem nao existir.
+   **/
+  int* dijkstra(string_view rotuloVOrigem) {
+    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
+    if (indiceRotuloOrigem == -1) return NULL;
+
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> fila;
+    vector<bool> indicesVerticesVisitados(qtdeVertices, false);
+    int* distancias = (int*)malloc(sizeof(int) * qtdeVertices);
+
+    for (int i = 0; i < qtdeVertices; i++) distancias[i] = POS_INF;
+
+    distancias[indiceRotuloOrigem] = 0;
+    fila.push({0, indiceRotuloOrigem});
+
+    while (!fila.empty()) {
+      int indiceVerticeFrenteFila = fila.top().second;
+      fila.pop();
+
+      if (indicesVerticesVisitados[indiceVerticeFrenteFila]) continue;
+      indicesVerticesVisitados[indiceVerticeFrenteFila] = true;
+
+      for (int64_t i = offsets[indiceVerticeFrenteFila]; i < offsets[indiceVerticeFrenteFila + 1]; i++) {
+        int indiceVerticeVizinho = destinos[i];
+
+        if (distancias[indiceVerticeFrenteFila] + pesos[i] < distancias[indiceVerticeVizinho]) {
+          distancias[indiceVerticeVizinho] = distancias[indiceVerticeFrenteFila] + pesos[i];
+          fila.push({distancias[indiceVerticeVizinho], indiceVerticeVizinho});
+        }
+      }
+    }
+
+    return distancias;
+  }
+
+  /**
+   * Mesmo algoritmo do KruskalMST de GrafoListaAdj: as arestas sao
+   * consideradas em ordem crescente de peso, e o union-find descarta as
+   * que fecham ciclos. Cada aresta escolhida aparece nos dois sentidos
+   * no grafo retornado, que eh montado em memoria.
+   **/
+  GrafoCSR* KruskalMST() {
+    vector<Aresta> arestasMenorPeso;
+    arestasMenorPeso.reserve(qtdeArestas);
+
+    for (int i = 0; i < qtdeVertices; i++) {
+      for (int64_t j = offsets[i]; j < offsets[i + 1]; j++) arestasMenorPeso.push_back(Aresta(i, destinos[j], pesos[j]));
+    }
+
+    stable_sort(arestasMenorPeso.begin(), arestasMenorPeso.end());
+
+    Grupo* grupos = (Grupo*)malloc(sizeof(Grupo) * qtdeVertices);
+    for (int i = 0; i < qtdeVertices; i++) {
+      grupos[i].pai = i;
+      grupos[i].tamanho = 1;
+    }
+
+    vector<Aresta> arestasMST;
+    for (const Aresta& prov : arestasMenorPeso) {
+      if (encontrarRaiz(grupos, prov.origem) != encontrarRaiz(grupos, prov.destino)) {
+        unirGrupos(grupos, prov.origem, prov.destino);
+
+        arestasMST.push_back(prov);
+        arestasMST.push_back(Aresta(prov.destino, prov.origem, prov.peso));
+      }
+    }
+    free(grupos);
+
+    vector<string> rotulos;
+    for (int i = 0; i < qtdeVertices; i++) rotulos.push_back(string(rotulo(i)));
+
+    return construir(rotulos, arestasMST);
+  }
+};
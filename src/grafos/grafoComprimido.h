@@ -0,0 +1,483 @@
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// a leitura SSSE3 dos grupos eh compilada mesmo sem -mssse3 e so eh
+// usada se o processador tiver suporte (veja setLeituraSSSE3)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LEITURA_SSSE3 __attribute__((target("ssse3")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define LEITURA_SSSE3
+#include <intrin.h>
+#endif
+
+#ifdef LEITURA_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#include "grafoCSR.h"
+
+using namespace std;
+
+// quantidade de vertices que compartilham uma base de 64 bits em offsetsVizinhos
+#define VERTICES_POR_BLOCO 1024
+
+/**
+ * Grafo somente-leitura com as listas de adjacencias comprimidas.
+ * Cada lista de vizinhos (ja ordenada, como no GrafoCSR) eh guardada como:
+ *   grau                    varint
+ *   posicao dos pesos       varint de 64 bits (ausente se todos os pesos forem 1)
+ *   diferencas              group-varint, em grupos de 4
+ * A primeira diferenca eh entre o primeiro vizinho e o proprio vertice
+ * (codificada em zigzag, pois pode ser negativa); as demais sao entre
+ * vizinhos consecutivos. Em grafos com boa localidade (ver reordenar),
+ * a maioria das diferencas cabe em 1 byte.
+ * No group-varint, um byte de controle guarda o tamanho (1 a 4 bytes)
+ * dos 4 valores seguintes, o que permite decodificar um grupo inteiro
+ * com um unico shuffle SSSE3 quando o processador tem suporte.
+ * Os pesos ficam em um fluxo separado (zigzag + varint), lido apenas
+ * por quem precisa deles. Se todos os pesos forem 1 (grafo nao ponderado),
+ * esse fluxo nao eh gravado.
+ **/
+class GrafoComprimido {
+ private:
+  int qtdeVertices;
+  int64_t qtdeArestas;
+  int grauMaximo;
+
+  // a lista do vertice v comeca em vizinhosDados[basesBlocos[v / VERTICES_POR_BLOCO] + offsetsVizinhos[v]];
+  // guardar apenas 32 bits por vertice reduz bastante a memoria em grafos de grau baixo
+  vector<int64_t> basesBlocos;
+  vector<uint32_t> offsetsVizinhos;
+  vector<uint8_t> vizinhosDados;
+
+  bool pesosUnitarios;
+  vector<uint8_t> pesosDados;
+
+  vector<int64_t> offsetsRotulos;
+  string bytesRotulos;
+  unordered_map<string_view, int> indicesVertices;
+
+  // grupos decodificados com SSSE3 em vez da versao escalar
+  bool leituraSSSE3;
+
+  GrafoComprimido() : qtdeVertices(0), qtdeArestas(0), grauMaximo(0), pesosUnitarios(true), leituraSSSE3(processadorTemSSSE3()) {}
+
+  static bool processadorTemSSSE3() {
+#if defined(LEITURA_SSSE3) && defined(__GNUC__)
+    return __builtin_cpu_supports("ssse3");
+#elif defined(LEITURA_SSSE3)
+    int registradores[4];
+    __cpuid(registradores, 1);
+    return (registradores[2] & (1 << 9)) != 0;
+#else
+    return false;
+#endif
+  }
+
+  static uint32_t zigzag(int32_t valor) {
+    return ((uint32_t)valor << 1) ^ (uint32_t)(valor >> 31);
+  }
+
+  static int32_t desfazerZigzag(uint32_t valor) {
+    return (int32_t)(valor >> 1) ^ -(int32_t)(valor & 1);
+  }
+
+  static void escreverVarint(vector<uint8_t>& saida, uint64_t valor) {
+    while (valor >= 0x80) {
+      saida.push_back((valor & 0x7F) | 0x80);
+      valor >>= 7;
+    }
+    saida.push_back(valor);
+  }
+
+  static uint32_t lerVarint(const uint8_t*& p) {
+    uint32_t valor = 0;
+    int deslocamento = 0;
+
+    while (*p & 0x80) {
+      valor |= (uint32_t)(*p++ & 0x7F) << deslocamento;
+      deslocamento += 7;
+    }
+    valor |= (uint32_t)(*p++) << deslocamento;
+
+    return valor;
+  }
+
+  // posicoes no fluxo de pesos passam de 32 bits em grafos grandes
+  static uint64_t lerVarint64(const uint8_t*& p) {
+    uint64_t valor = 0;
+    int deslocamento = 0;
+
+    while (*p & 0x80) {
+      valor |= (uint64_t)(*p++ & 0x7F) << deslocamento;
+      deslocamento += 7;
+    }
+    valor |= (uint64_t)(*p++) << deslocamento;
+
+    return valor;
+  }
+
+  static int bytesNecessarios(uint32_t valor) {
+    if (valor < (1u << 8)) return 1;
+    if (valor < (1u << 16)) return 2;
+    if (valor < (1u << 24)) return 3;
+    return 4;
+  }
+
+  static void escreverGrupo(vector<uint8_t>& saida, const uint32_t* valores) {
+    size_t posControle = saida.size();
+    uint8_t controle = 0;
+
+    saida.push_back(0);
+    for (int i = 0; i < 4; i++) {
+      int tamanho = bytesNecessarios(valores[i]);
+      controle |= (tamanho - 1) << (2 * i);
+      for (int b = 0; b < tamanho; b++) saida.push_back((valores[i] >> (8 * b)) & 0xFF);
+    }
+    saida[posControle] = controle;
+  }
+
+  // tabelas indexadas pelo byte de controle de um grupo
+  class TabelasGrupo {
+   public:
+    uint8_t tamanhoGrupo[256];
+    uint8_t mascaras[256][16];
+
+    TabelasGrupo() {
+      for (int controle = 0; controle < 256; controle++) {
+        int pos = 0;
+        for (int i = 0; i < 4; i++) {
+          int tamanho = ((controle >> (2 * i)) & 3) + 1;
+          for (int b = 0; b < 4; b++) mascaras[controle][4 * i + b] = b < tamanho ? pos + b : 0x80;
+          pos += tamanho;
+        }
+        tamanhoGrupo[controle] = pos;
+      }
+    }
+  };
+
+  static const TabelasGrupo& tabelas() {
+    static const TabelasGrupo tabelasGrupo;
+    return tabelasGrupo;
+  }
+
+  /**
+   * Decodificam os grupos com os grau valores de uma lista. A versao
+   * SSSE3 le 16 bytes por grupo; por isso vizinhosDados termina com 16
+   * bytes de folga.
+   **/
+  static void lerGrupos(const uint8_t* p, uint32_t* saida, int grau) {
+    const TabelasGrupo& t = tabelas();
+
+    for (int g = 0; g < grau; g += 4) {
+      uint8_t controle = *p++;
+      const uint8_t* q = p;
+
+      for (int i = 0; i < 4; i++) {
+        int tamanho = ((controle >> (2 * i)) & 3) + 1;
+        uint32_t valor = 0;
+        for (int b = 0; b < tamanho; b++) valor |= (uint32_t)q[b] << (8 * b);
+        saida[g + i] = valor;
+        q += tamanho;
+      }
+
+      p += t.tamanhoGrupo[controle];
+    }
+  }
+
+#ifdef LEITURA_SSSE3
+  LEITURA_SSSE3 static void lerGruposSSSE3(const uint8_t* p, uint32_t* saida, int grau) {
+    const TabelasGrupo& t = tabelas();
+
+    for (int g = 0; g < grau; g += 4) {
+      uint8_t controle = *p++;
+      __m128i dados = _mm_loadu_si128((const __m128i*)p);
+      __m128i mascara = _mm_loadu_si128((const __m128i*)t.mascaras[controle]);
+      _mm_storeu_si128((__m128i*)(saida + g), _mm_shuffle_epi8(dados, mascara));
+
+      p += t.tamanhoGrupo[controle];
+    }
+  }
+#endif
+
+  const uint8_t* inicioLista(int v) {
+    return vizinhosDados.data() + basesBlocos[v / VERTICES_POR_BLOCO] + offsetsVizinhos[v];
+  }
+
+  void adicionarLista(int v, const int* destinos, const int* pesos, int grau) {
+    if (v % VERTICES_POR_BLOCO == 0) basesBlocos.push_back(vizinhosDados.size());
+    offsetsVizinhos.push_back(vizinhosDados.size() - basesBlocos.back());
+    escreverVarint(vizinhosDados, grau);
+    if (!pesosUnitarios) escreverVarint(vizinhosDados, (uint64_t)pesosDados.size());
+
+    uint32_t grupo[4];
+    int anterior = v;
+    for (int i = 0; i < grau; i += 4) {
+      for (int k = 0; k < 4; k++) {
+        if (i + k >= grau) {
+          grupo[k] = 0;
+        } else if (i + k == 0) {
+          grupo[k] = zigzag(destinos[0] - v);
+        } else {
+          grupo[k] = destinos[i + k] - anterior;
+        }
+        if (i + k < grau) anterior = destinos[i + k];
+      }
+      escreverGrupo(vizinhosDados, grupo);
+    }
+
+    if (!pesosUnitarios) {
+      for (int i = 0; i < grau; i++) escreverVarint(pesosDados, zigzag(pesos[i]));
+    }
+  }
+
+ public:
+  GrafoComprimido(const GrafoComprimido&) = delete;
+  GrafoComprimido& operator=(const GrafoComprimido&) = delete;
+
+  /**
+   * Comprime um GrafoCSR (cujas listas de vizinhos ja estao ordenadas).
+   **/
+  static GrafoComprimido* comprimir(GrafoCSR* csr) {
+    GrafoComprimido* grafo = new GrafoComprimido();
+    const int64_t* offsets = csr->getOffsets();
+
+    grafo->qtdeVertices = csr->numVertices();
+    grafo->qtdeArestas = csr->numArestas();
+    grafo->offsetsVizinhos.reserve(grafo->qtdeVertices);
+    grafo->offsetsRotulos.push_back(0);
+
+    for (int64_t i = 0; i < grafo->qtdeArestas; i++) {
+      if (csr->getPesos()[i] != 1) grafo->pesosUnitarios = false;
+    }
+
+    for (int v = 0; v < grafo->qtdeVertices; v++) {
+      int grau = csr->grau(v);
+      grafo->adicionarLista(v, csr->getDestinos() + offsets[v], csr->getPesos() + offsets[v], grau);
+      grafo->grauMaximo = max(grafo->grauMaximo, grau);
+
+      string_view rotulo = csr->rotulo(v);
+      grafo->bytesRotulos.append(rotulo.data(), rotulo.size());
+      grafo->offsetsRotulos.push_back(grafo->bytesRotulos.size());
+    }
+
+    // folga para a leitura de 16 bytes do ultimo grupo
+    grafo->vizinhosDados.resize(grafo->vizinhosDados.size() + 16, 0);
+    grafo->vizinhosDados.shrink_to_fit();
+    grafo->pesosDados.shrink_to_fit();
+
+    return grafo;
+  }
+
+  /**
+   * Escreve em saida os vizinhos do vertice e retorna o grau.
+   * saida precisa ter espaco para getGrauMaximo() + 3 inteiros, pois
+   * o ultimo grupo eh sempre decodificado por inteiro.
+   **/
+  int decodificarVizinhos(int indiceVertice, int* saida) {
+    const uint8_t* p = inicioLista(indiceVertice);
+    int grau = lerVarint(p);
+    uint32_t* valores = (uint32_t*)saida;
+
+    if (!pesosUnitarios) lerVarint64(p);
+
+#ifdef LEITURA_SSSE3
+    if (leituraSSSE3) {
+      lerGruposSSSE3(p, valores, grau);
+    } else {
+      lerGrupos(p, valores, grau);
+    }
+#else
+    lerGrupos(p, valores, grau);
+#endif
+
+    if (grau > 0) saida[0] = indiceVertice + desfazerZigzag(valores[0]);
+    for (int i = 1; i < grau; i++) saida[i] = saida[i - 1] + (int)valores[i];
+
+    return grau;
+  }
+
+  /**
+   * Escreve em saida os pesos das arestas do vertice, na mesma ordem
+   * de decodificarVizinhos, e retorna o grau.
+   **/
+  int decodificarPesos(int indiceVertice, int* saida) {
+    const uint8_t* cabecalho = inicioLista(indiceVertice);
+    int grau = lerVarint(cabecalho);
+
+    if (pesosUnitarios) {
+      for (int i = 0; i < grau; i++) saida[i] = 1;
+      return grau;
+    }
+
+    const uint8_t* p = pesosDados.data() + lerVarint64(cabecalho);
+    for (int i = 0; i < grau; i++) saida[i] = desfazerZigzag(lerVarint(p));
+
+    return grau;
+  }
+
+  /**
+   * Escolhe a decodificacao SSSE3 (ativar true) ou a escalar. Por padrao
+   * a SSSE3 eh usada quando o processador tem suporte; sem suporte ela
+   * nunca eh ativada.
+   * Retorna se a decodificacao SSSE3 ficou ativa.
+   **/
+  bool setLeituraSSSE3(bool ativar) {
+    leituraSSSE3 = ativar && processadorTemSSSE3();
+    return leituraSSSE3;
+  }
+
+  int obterIndiceVertice(string_view rotuloVertice) {
+    if (indicesVertices.empty() && qtdeVertices > 0) {
+      indicesVertices.reserve(qtdeVertices);
+      for (int v = 0; v < qtdeVertices; v++) indicesVertices.emplace(rotulo(v), v);
+    }
+
+    auto it = indicesVertices.find(rotuloVertice);
+    if (it == indicesVertices.end()) return -1;
+    return it->second;
+  }
+
+  string_view rotulo(int indiceVertice) {
+    return string_view(bytesRotulos.data() + offsetsRotulos[indiceVertice],
+                       offsetsRotulos[indiceVertice + 1] - offsetsRotulos[indiceVertice]);
+  }
+
+  int numVertices() {
+    return qtdeVertices;
+  }
+
+  int64_t numArestas() {
+    return qtdeArestas;
+  }
+
+  int getGrauMaximo() {
+    return grauMaximo;
+  }
+
+  /**
+   * Memoria ocupada pelas arestas (vizinhos, pesos e offsets), sem os rotulos.
+   **/
+  int64_t bytesArestas() {
+    return vizinhosDados.size() + pesosDados.size() + offsetsVizinhos.size() * sizeof(uint32_t) + basesBlocos.size() * sizeof(int64_t);
+  }
+
+  /**
+   * Mesma semantica do bfs de GrafoListaAdj: vertices inalcancaveis
+   * ficam com distancia 0.
+   * Retorna NULL se o vertice de origem nao existir.
+   **/
+  int* bfs(string_view rotuloVOrigem) {
+    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
+    if (indiceRotuloOrigem == -1) return NULL;
+
+    int* distancias = (int*)malloc(sizeof(int) * qtdeVertices);
+    vector<bool> indicesVerticesVisitados(qtdeVertices, false);
+    vector<int> vizinhos(grauMaximo + 4);
+
+    for (int i = 0; i < qtdeVertices; i++) distancias[i] = 0;
+
+    queue<int> fila;
+
+    indicesVerticesVisitados[indiceRotuloOrigem] = true;
+    fila.push(indiceRotuloOrigem);
+
+    while (!fila.empty()) {
+      int indiceVerticeFrenteFila = fila.front();
+      fila.pop();
+
+      int grau = decodificarVizinhos(indiceVerticeFrenteFila, vizinhos.data());
+      for (int i = 0; i < grau; i++) {
+        if (!indicesVerticesVisitados[vizinhos[i]]) {
+          indicesVerticesVisitados[vizinhos[i]] = true;
+          distancias[vizinhos[i]] = distancias[indiceVerticeFrenteFila] + 1;
+          fila.push(vizinhos[i]);
+        }
+      }
+    }
+
+    return distancias;
+  }
+
+  /**
+   * Mesma semantica do haCaminho de GrafoListaAdj: um vertice so tem
+   * caminho para si mesmo se houver um laco.
+   **/
+  bool haCaminho(string_view rotuloVOrigem, string_view rotuloVDestino) {
+    int origem = obterIndiceVertice(rotuloVOrigem);
+    int destino = obterIndiceVertice(rotuloVDestino);
+
+    if (origem == -1 || destino == -1) return false;
+
+    vector<bool> indicesVerticesVisitados(qtdeVertices, false);
+    vector<int> vizinhos(grauMaximo + 4);
+    vector<int> pilha;
+
+    if (origem == destino) {
+      int grau = decodificarVizinhos(origem, vizinhos.data());
+      return binary_search(vizinhos.begin(), vizinhos.begin() + grau, origem);
+    }
+
+    indicesVerticesVisitados[origem] = true;
+    pilha.push_back(origem);
+    while (!pilha.empty()) {
+      int v = pilha.back();
+      pilha.pop_back();
+
+      int grau = decodificarVizinhos(v, vizinhos.data());
+      for (int i = 0; i < grau; i++) {
+        if (vizinhos[i] == destino) return true;
+        if (!indicesVerticesVisitados[vizinhos[i]]) {
+          indicesVerticesVisitados[vizinhos[i]] = true;
+          pilha.push_back(vizinhos[i]);
+        }
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Identifica os componentes do grafo. Como o grafo eh somente-leitura,
+   * em vez de mudar os rotulos escrevemos em componentes[v] o numero
+   * (a partir de 1) do componente de cada vertice.
+   * Retorna a quantidade de componentes.
+   **/
+  int colorir(int* componentes) {
+    vector<int> vizinhos(grauMaximo + 4);
+    vector<int> pilha;
+    int cores = 0;
+
+    for (int i = 0; i < qtdeVertices; i++) componentes[i] = 0;
+
+    for (int i = 0; i < qtdeVertices; i++) {
+      if (componentes[i] != 0) continue;
+
+      cores++;
+      componentes[i] = cores;
+      pilha.push_back(i);
+
+      while (!pilha.empty()) {
+        int v = pilha.back();
+        pilha.pop_back();
+
+        int grau = decodificarVizinhos(v, vizinhos.data());
+        for (int k = 0; k < grau; k++) {
+          if (componentes[vizinhos[k]] == 0) {
+            componentes[vizinhos[k]] = cores;
+            pilha.push_back(vizinhos[k]);
+          }
+        }
+      }
+    }
+
+    return cores;
+  }
+};
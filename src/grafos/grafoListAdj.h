@@ -1,41 +1,427 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
 #include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 using namespace std;
 
+// grau a partir do qual um vertice passa a ter um conjunto hash de destinos
+#define LIMIAR_HUB 64
+
+// quantidade de vizinhos guardados dentro do proprio vertice, sem alocacao
+#define VIZINHOS_INLINE 3
+
+// quantidade de pares de cada pedaco de memoria pedido pela arena
+#define PARES_POR_PEDACO 8192
+
+/**
+ * Arena para as listas de vizinhos que nao cabem inline.
+ * Os blocos tem capacidade potencia de 2 e sao cortados de pedacos grandes,
+ * entao criar milhoes de listas nao gera milhoes de mallocs.
+ * Quando uma lista cresce, seu bloco antigo vai para a lista de livres da
+ * sua capacidade e eh reaproveitado; a memoria so volta ao sistema quando
+ * a arena eh destruida.
+ **/
+class ArenaVizinhos {
+ private:
+  vector<pair<int, int>*> pedacos;
+  pair<int, int>* atual;
+  int restante;
+
+  // livres[k] guarda blocos com capacidade 2^k
+  vector<pair<int, int>*> livres[32];
+
+  static int classe(int capacidade) {
+    int k = 0;
+    while ((1 << k) < capacidade) k++;
+    return k;
+  }
+
+ public:
+  ArenaVizinhos() : atual(NULL), restante(0) {}
+
+  ~ArenaVizinhos() {
+    for (pair<int, int>* pedaco : pedacos) free(pedaco);
+  }
+
+  ArenaVizinhos(const ArenaVizinhos&) = delete;
+  ArenaVizinhos& operator=(const ArenaVizinhos&) = delete;
+
+  /**
+   * capacidade deve ser potencia de 2.
+   **/
+  pair<int, int>* alocar(int capacidade) {
+    vector<pair<int, int>*>& livresClasse = livres[classe(capacidade)];
+
+    if (!livresClasse.empty()) {
+      pair<int, int>* bloco = livresClasse.back();
+      livresClasse.pop_back();
+      return bloco;
+    }
+
+    if (capacidade > PARES_POR_PEDACO) {
+      pair<int, int>* bloco = (pair<int, int>*)malloc(sizeof(pair<int, int>) * capacidade);
+      pedacos.push_back(bloco);
+      return bloco;
+    }
+
+    if (restante < capacidade) {
+      atual = (pair<int, int>*)malloc(sizeof(pair<int, int>) * PARES_POR_PEDACO);
+      pedacos.push_back(atual);
+      restante = PARES_POR_PEDACO;
+    }
+
+    pair<int, int>* bloco = atual;
+    atual += capacidade;
+    restante -= capacidade;
+    return bloco;
+  }
+
+  void liberar(pair<int, int>* bloco, int capacidade) {
+    livres[classe(capacidade)].push_back(bloco);
+  }
+};
+
+/**
+ * Lista de vizinhos com os primeiros VIZINHOS_INLINE pares guardados no
+ * proprio objeto. Como a maioria dos vertices tem grau baixo, quase nenhuma
+ * lista precisa de memoria externa; as que crescem alem disso passam a usar
+ * um bloco da ArenaVizinhos.
+ * O objeto nao libera memoria sozinho: os blocos pertencem a arena.
+ **/
+class ListaVizinhos {
+ private:
+  int tamanho;
+  int capacidade;
+
+  union {
+    pair<int, int> inlineDados[VIZINHOS_INLINE];
+    pair<int, int>* externo;
+  };
+
+  bool ehInline() const {
+    return capacidade == VIZINHOS_INLINE;
+  }
+
+  /**
+   * Move os pares para um bloco da arena com novaCapacidade, que deve ser
+   * potencia de 2 e maior que a capacidade atual.
+   **/
+  void realocar(int novaCapacidade, ArenaVizinhos& arena) {
+    pair<int, int>* novoBloco = arena.alocar(novaCapacidade);
+
+    copy(begin(), end(), novoBloco);
+    if (!ehInline()) arena.liberar(externo, capacidade);
+
+    externo = novoBloco;
+    capacidade = novaCapacidade;
+  }
+
+  void crescer(ArenaVizinhos& arena) {
+    realocar(ehInline() ? 8 : 2 * capacidade, arena);
+  }
+
+ public:
+  ListaVizinhos() : tamanho(0), capacidade(VIZINHOS_INLINE), inlineDados() {}
+
+  ListaVizinhos(const ListaVizinhos& outra) : tamanho(outra.tamanho), capacidade(outra.capacidade) {
+    if (outra.ehInline()) {
+      copy(outra.inlineDados, outra.inlineDados + VIZINHOS_INLINE, inlineDados);
+    } else {
+      externo = outra.externo;
+    }
+  }
+
+  ListaVizinhos& operator=(const ListaVizinhos& outra) {
+    tamanho = outra.tamanho;
+    capacidade = outra.capacidade;
+    if (outra.ehInline()) {
+      copy(outra.inlineDados, outra.inlineDados + VIZINHOS_INLINE, inlineDados);
+    } else {
+      externo = outra.externo;
+    }
+    return *this;
+  }
+
+  pair<int, int>* data() {
+    return ehInline() ? inlineDados : externo;
+  }
+
+  const pair<int, int>* data() const {
+    return ehInline() ? inlineDados : externo;
+  }
+
+  pair<int, int>* begin() {
+    return data();
+  }
+
+  pair<int, int>* end() {
+    return data() + tamanho;
+  }
+
+  const pair<int, int>* begin() const {
+    return data();
+  }
+
+  const pair<int, int>* end() const {
+    return data() + tamanho;
+  }
+
+  int size() const {
+    return tamanho;
+  }
+
+  const pair<int, int>& operator[](int i) const {
+    return data()[i];
+  }
+
+  void push_back(const pair<int, int>& par, ArenaVizinhos& arena) {
+    if (tamanho == capacidade) crescer(arena);
+    data()[tamanho++] = par;
+  }
+
+  void inserir(int pos, const pair<int, int>& par, ArenaVizinhos& arena) {
+    if (tamanho == capacidade) crescer(arena);
+
+    pair<int, int>* dados = data();
+    copy_backward(dados + pos, dados + tamanho, dados + tamanho + 1);
+    dados[pos] = par;
+    tamanho++;
+  }
+
+  /**
+   * Garante espaco para pelo menos capacidadeMinima pares. Depois disso,
+   * push_back nao usa a arena ate a lista passar dessa capacidade.
+   * O bloco tem a menor potencia de 2 que comporta capacidadeMinima e eh
+   * alocado de uma vez, sem passar pelas capacidades intermediarias.
+   **/
+  void reservar(int capacidadeMinima, ArenaVizinhos& arena) {
+    if (capacidade >= capacidadeMinima) return;
+
+    int novaCapacidade = 8;
+    while (novaCapacidade < capacidadeMinima) novaCapacidade *= 2;
+    realocar(novaCapacidade, arena);
+  }
+
+  /**
+   * Descarta os pares a partir da posicao novoTamanho.
+   **/
+  void truncar(int novoTamanho) {
+    tamanho = novoTamanho;
+  }
+
+  /**
+   * Copia apenas esta lista para um vetor.
+   **/
+  operator vector<pair<int, int>>() const {
+    return vector<pair<int, int>>(begin(), end());
+  }
+};
+
+/**
+ * Visao somente-leitura das listas de vizinhos de todos os vertices,
+ * retornada por getArestas sem copiar nada. Para o codigo que usa o tipo
+ * antigo, ela tambem se converte (copiando) em vector<vector<pair<int, int>>>.
+ **/
+class ListasVizinhos {
+ private:
+  const vector<ListaVizinhos>* listas;
+
+ public:
+  explicit ListasVizinhos(const vector<ListaVizinhos>& listas) : listas(&listas) {}
+
+  size_t size() const {
+    return listas->size();
+  }
+
+  bool empty() const {
+    return listas->empty();
+  }
+
+  const ListaVizinhos& at(size_t i) const {
+    return listas->at(i);
+  }
+
+  const ListaVizinhos& operator[](size_t i) const {
+    return (*listas)[i];
+  }
+
+  vector<ListaVizinhos>::const_iterator begin() const {
+    return listas->begin();
+  }
+
+  vector<ListaVizinhos>::const_iterator end() const {
+    return listas->end();
+  }
+
+  operator vector<vector<pair<int, int>>>() const {
+    vector<vector<pair<int, int>>> copia;
+    copia.reserve(listas->size());
+    for (const ListaVizinhos& lista : *listas) copia.push_back(lista);
+    return copia;
+  }
+};
+
+/**
+ * Aresta a ser inserida em lote por inserirArestas.
+ **/
+class EspecAresta {
+ public:
+  string origem;
+  string destino;
+  int peso;
+
+  EspecAresta(string origem, string destino, int peso = 1) : origem(origem), destino(destino), peso(peso) {}
+};
+
+/**
+ * Aresta a ser inserida em lote por inserirArestasIdx, usando os indices
+ * dos vertices em vez dos rotulos.
+ **/
+class EspecArestaIdx {
+ public:
+  int origem;
+  int destino;
+  int peso;
+
+  EspecArestaIdx() {}
+  EspecArestaIdx(int origem, int destino, int peso = 1) : origem(origem), destino(destino), peso(peso) {}
+};
+
 class GrafoListaAdj {
  private:
 
   vector<string> vertices;
 
   // first eh o indice do vertice, second eh o peso (caso o grafo seja ponderado)
-  vector<vector<pair<int, int>>> arestas;
+  vector<ListaVizinhos> arestas;
+
+  // memoria das listas de vizinhos que nao cabem inline
+  ArenaVizinhos arena;
+
+  // indice de cada rotulo em vertices
+  unordered_map<string, int> indicesVertices;
+
+  // no modo ordenado cada lista de vizinhos fica ordenada pelo indice
+  // do destino e nao possui arestas repetidas
+  bool adjacenciaOrdenada;
+
+  // no modo ordenado, vertices com grau acima de LIMIAR_HUB tambem guardam
+  // seus destinos em um conjunto hash, para que saoConectados seja O(1)
+  unordered_map<int, unordered_set<int>> destinosHubs;
+
+  /**
+   * Como nao temos nenhuma ordenacao usando os rotulos, mantemos
+   * uma tabela hash de rotulo para indice em vez de usar busca linear.
+   **/
+  int obterIndiceVertice(const string& rotuloVertice) {
+    auto it = indicesVertices.find(rotuloVertice);
+    if (it == indicesVertices.end()) return -1;
+    return it->second;
+  }
+
+  static bool destinoMenor(const pair<int, int>& aresta, int destino) {
+    return aresta.first < destino;
+  }
 
   /**
-   * A principio nao temos nenhuma ordenacao usando os rotulos.
-   * Portanto, usaremos busca linear.
+   * Insere mantendo a lista ordenada. Se a aresta ja existir,
+   * ficamos com o menor dos pesos.
    **/
-  int obterIndiceVertice(string rotuloVertice) {
-    for (int i = 0; i < vertices.size(); i++) {
-      if (vertices[i] == rotuloVertice) return i;
+  void inserirArestaOrdenada(int origem, int destino, int peso) {
+    ListaVizinhos& lista = arestas[origem];
+    pair<int, int>* pos = lower_bound(lista.begin(), lista.end(), destino, destinoMenor);
+
+    if (pos != lista.end() && pos->first == destino) {
+      pos->second = min(pos->second, peso);
+      return;
+    }
+
+    lista.inserir(pos - lista.begin(), pair<int, int>(destino, peso), arena);
+
+    if (lista.size() == LIMIAR_HUB + 1) {
+      unordered_set<int>& destinos = destinosHubs[origem];
+      for (const pair<int, int>& aresta : lista) destinos.insert(aresta.first);
+    } else if (lista.size() > LIMIAR_HUB + 1) {
+      destinosHubs[origem].insert(destino);
     }
-    return -1;
+  }
+
+  void inserirAresta(int origem, int destino, int peso) {
+    if (adjacenciaOrdenada) {
+      inserirArestaOrdenada(origem, destino, peso);
+    } else {
+      pair<int, int> par;
+
+      par.first = destino;
+      par.second = peso;
+
+      arestas[origem].push_back(par, arena);
+    }
+  }
+
+  /**
+   * No modo ordenado, uma lista preenchida em lote eh ordenada por
+   * (destino, peso) e as arestas repetidas sao descartadas, ficando
+   * a de menor peso.
+   **/
+  void ordenarSemRepetidas(ListaVizinhos& lista) {
+    sort(lista.begin(), lista.end());
+
+    int tamanho = 0;
+    for (int i = 0; i < lista.size(); i++) {
+      if (tamanho == 0 || lista.begin()[tamanho - 1].first != lista[i].first) lista.begin()[tamanho++] = lista[i];
+    }
+    lista.truncar(tamanho);
+  }
+
+  /**
+   * Executa funcao(t) para t = 0 .. numThreads - 1, cada uma em uma thread.
+   **/
+  template <typename Funcao>
+  static void executarEmParalelo(int numThreads, Funcao funcao) {
+    if (numThreads <= 1) {
+      funcao(0);
+      return;
+    }
+
+    vector<thread> threads;
+    for (int t = 0; t < numThreads; t++) threads.emplace_back(funcao, t);
+    for (int t = 0; t < numThreads; t++) threads[t].join();
   }
 
  public:
+  GrafoListaAdj() : adjacenciaOrdenada(false) {}
+
+  /**
+   * Se adjacenciaOrdenada for true, as listas de vizinhos ficam ordenadas
+   * e sem arestas paralelas: inserir uma aresta repetida apenas mantem o
+   * menor peso. Assim saoConectados usa busca binaria, ou o conjunto hash
+   * dos vertices com grau alto.
+   **/
+  GrafoListaAdj(bool adjacenciaOrdenada) : adjacenciaOrdenada(adjacenciaOrdenada) {}
+
+  // as listas de vizinhos apontam para a arena deste grafo
+  GrafoListaAdj(const GrafoListaAdj&) = delete;
+  GrafoListaAdj& operator=(const GrafoListaAdj&) = delete;
 
   /**
    * Lembrem-se:
    *       1) nao podemos inserir vertices com mesmo rotulo
    *       2) toda vez que inserirmos um novo vertice, precisaremos
-   *          inserir um vetor para representar as conexoes daquele
-   *          vertice na lista de adjacencias
+   *          inserir uma lista para representar as conexoes daquele
+   *          vertice na lista de adjacencias (vazia, ela nao aloca memoria)
    **/
   void inserirVertice(string rotuloVertice) {
     int existeRotulo = obterIndiceVertice(rotuloVertice);
     if (existeRotulo == -1) {
+      indicesVertices[rotuloVertice] = vertices.size();
       vertices.push_back(rotuloVertice);
-      vector<pair<int, int>> v;
-      arestas.push_back(v);
+      arestas.push_back(ListaVizinhos());
     } else
       return;
   }
@@ -49,13 +435,20 @@ class GrafoListaAdj {
   }
 
   void inserirArestaNaoDirecionada(string rotuloVOrigem, string rotuloVDestino) {
-    inserirArestaDirecionada(rotuloVOrigem, rotuloVDestino, 1);
-    inserirArestaDirecionada(rotuloVDestino, rotuloVOrigem, 1);
+    inserirArestaNaoDirecionada(rotuloVOrigem, rotuloVDestino, 1);
   }
 
+  /**
+   * Os rotulos sao resolvidos uma unica vez para os dois sentidos.
+   **/
   void inserirArestaNaoDirecionada(string rotuloVOrigem, string rotuloVDestino, int peso) {
-    inserirArestaDirecionada(rotuloVOrigem, rotuloVDestino, peso);
-    inserirArestaDirecionada(rotuloVDestino, rotuloVOrigem, peso);
+    int origem = obterIndiceVertice(rotuloVOrigem);
+    int destino = obterIndiceVertice(rotuloVDestino);
+
+    if (origem == -1 || destino == -1) return;
+
+    inserirAresta(origem, destino, peso);
+    inserirAresta(destino, origem, peso);
   }
 
   /**
@@ -66,21 +459,138 @@ class GrafoListaAdj {
     int origem = obterIndiceVertice(rotuloVOrigem);
     int destino = obterIndiceVertice(rotuloVDestino);
 
-    if (origem != -1 && destino != -1) {
-      pair<int, int> par;
+    if (origem == -1 || destino == -1) return;
 
-      par.first = destino;
-      par.second = peso;
+    inserirAresta(origem, destino, peso);
+  }
+
+  /**
+   * Insere qtde arestas de uma vez. Cada rotulo eh resolvido uma unica
+   * vez e as arestas com rotulos inexistentes sao ignoradas, como em
+   * inserirArestaDirecionada. Se naoDirecionadas for true, cada aresta
+   * eh inserida nos dois sentidos.
+   * O resultado eh o mesmo de inserir as arestas uma a uma, na mesma ordem.
+   **/
+  void inserirArestas(const EspecAresta* especs, int qtde, bool naoDirecionadas = false, int numThreads = 1) {
+    vector<EspecArestaIdx> especsIdx;
+    especsIdx.reserve(qtde);
+
+    for (int i = 0; i < qtde; i++) {
+      int origem = obterIndiceVertice(especs[i].origem);
+      int destino = obterIndiceVertice(especs[i].destino);
+      if (origem != -1 && destino != -1) especsIdx.push_back(EspecArestaIdx(origem, destino, especs[i].peso));
+    }
+
+    inserirArestasIdx(especsIdx.data(), especsIdx.size(), naoDirecionadas, numThreads);
+  }
+
+  void inserirArestas(const vector<EspecAresta>& especs, bool naoDirecionadas = false, int numThreads = 1) {
+    inserirArestas(especs.data(), especs.size(), naoDirecionadas, numThreads);
+  }
+
+  /**
+   * Versao de inserirArestas que recebe indices de vertices, sem nenhuma
+   * busca por rotulo. Arestas com indices invalidos sao ignoradas.
+   * Primeiro contamos quantas arestas cada vertice vai receber e reservamos
+   * cada lista uma unica vez; depois as listas sao preenchidas em uma
+   * passada. Com numThreads > 1, as arestas sao antes agrupadas pelo
+   * vertice dono da lista (com as contagens da primeira passada) e cada
+   * thread preenche um intervalo contiguo de vertices com cerca de
+   * qtde / numThreads arestas, entao nenhuma lista eh escrita por duas
+   * threads e cada aresta eh lida por uma so.
+   **/
+  void inserirArestasIdx(const EspecArestaIdx* especs, int qtde, bool naoDirecionadas = false, int numThreads = 1) {
+    int numVertices = vertices.size();
+    vector<int> graus(numVertices, 0);
+    if (numThreads < 1) numThreads = 1;
+
+    auto valida = [&](const EspecArestaIdx& espec) {
+      return espec.origem >= 0 && espec.origem < numVertices && espec.destino >= 0 && espec.destino < numVertices;
+    };
 
-      for (int i = 0; i < arestas.size(); i++) {
-        if (i == origem) {
-          arestas[i].push_back(par);
-          return;
+    for (int i = 0; i < qtde; i++) {
+      if (!valida(especs[i])) continue;
+
+      graus[especs[i].origem]++;
+      if (naoDirecionadas) graus[especs[i].destino]++;
+    }
+
+    // a arena nao eh thread-safe, entao toda alocacao acontece aqui
+    for (int v = 0; v < numVertices; v++) {
+      if (graus[v] > 0) arestas[v].reservar(arestas[v].size() + graus[v], arena);
+    }
+
+    // sentidoInverso: a aresta vai para a lista do destino
+    auto inserirEspec = [&](int i, bool sentidoInverso) {
+      const EspecArestaIdx& espec = especs[i];
+      if (sentidoInverso) arestas[espec.destino].push_back(pair<int, int>(espec.origem, espec.peso), arena);
+      else arestas[espec.origem].push_back(pair<int, int>(espec.destino, espec.peso), arena);
+    };
+
+    if (numThreads == 1) {
+      for (int i = 0; i < qtde; i++) {
+        if (!valida(especs[i])) continue;
+
+        inserirEspec(i, false);
+        if (naoDirecionadas) inserirEspec(i, true);
+      }
+
+      if (adjacenciaOrdenada) {
+        for (int v = 0; v < numVertices; v++) {
+          if (graus[v] > 0) ordenarSemRepetidas(arestas[v]);
         }
       }
+    } else {
+      // inicios[v]: posicao das arestas de v em porVertice
+      vector<int64_t> inicios(numVertices + 1, 0);
+      for (int v = 0; v < numVertices; v++) inicios[v + 1] = inicios[v] + graus[v];
+
+      // arestas agrupadas pelo vertice dono da lista, na ordem de especs;
+      // ~i indica a aresta i no sentido destino -> origem
+      vector<int> porVertice(inicios[numVertices]);
+      vector<int64_t> proximas(inicios.begin(), inicios.end() - 1);
+      for (int i = 0; i < qtde; i++) {
+        if (!valida(especs[i])) continue;
+
+        porVertice[proximas[especs[i].origem]++] = i;
+        if (naoDirecionadas) porVertice[proximas[especs[i].destino]++] = ~i;
+      }
+
+      // a thread t fica com os vertices [limites[t], limites[t + 1])
+      vector<int> limites(numThreads + 1, numVertices);
+      for (int t = 0; t < numThreads; t++) {
+        int64_t alvo = inicios[numVertices] * t / numThreads;
+        limites[t] = lower_bound(inicios.begin(), inicios.end(), alvo) - inicios.begin();
+      }
+
+      executarEmParalelo(numThreads, [&](int t) {
+        for (int v = limites[t]; v < limites[t + 1]; v++) {
+          for (int64_t k = inicios[v]; k < inicios[v + 1]; k++) {
+            int i = porVertice[k];
+            if (i >= 0) inserirEspec(i, false);
+            else inserirEspec(~i, true);
+          }
+
+          if (adjacenciaOrdenada && graus[v] > 0) ordenarSemRepetidas(arestas[v]);
+        }
+      });
+    }
+
+    if (!adjacenciaOrdenada) return;
+
+    for (int v = 0; v < numVertices; v++) {
+      if (graus[v] == 0 || arestas[v].size() <= LIMIAR_HUB) continue;
+
+      unordered_set<int>& destinos = destinosHubs[v];
+      destinos.clear();
+      for (const pair<int, int>& aresta : arestas[v]) destinos.insert(aresta.first);
     }
   }
 
+  void inserirArestasIdx(const vector<EspecArestaIdx>& especs, bool naoDirecionadas = false, int numThreads = 1) {
+    inserirArestasIdx(especs.data(), especs.size(), naoDirecionadas, numThreads);
+  }
+
   /**
    * Verifica se vertice rotuloVOrigem e vertice rotuloVDestino sao
    * conectados (vizinhos).
@@ -89,23 +599,79 @@ class GrafoListaAdj {
     int origem = obterIndiceVertice(rotuloVOrigem);
     int destino = obterIndiceVertice(rotuloVDestino);
 
-    if (origem == -1 || destino == -1)
-      return false;
-    else {
-      for (int i = 0; i < arestas.size(); i++) {
-        if (i == origem) {
-          for (int j = 0; j < arestas[i].size(); j++) {
-            if (arestas[i][j].first == destino) {
-              return true;
-            }
-          }
-          return false;
-        }
-      }
+    if (origem == -1 || destino == -1) return false;
+
+    const ListaVizinhos& lista = arestas[origem];
+
+    if (adjacenciaOrdenada) {
+      if (lista.size() > LIMIAR_HUB) return destinosHubs[origem].count(destino) > 0;
+
+      const pair<int, int>* pos = lower_bound(lista.begin(), lista.end(), destino, destinoMenor);
+      return pos != lista.end() && pos->first == destino;
+    }
+
+    for (int j = 0; j < lista.size(); j++) {
+      if (lista[j].first == destino) return true;
+    }
+    return false;
+  }
+
+  /**
+   * Visao somente-leitura de uma lista de vizinhos.
+   * Aponta diretamente para a lista interna, entao nao ha copia nem alocacao,
+   * mas deixa de ser valida se o grafo for modificado.
+   **/
+  class Vizinhos {
+   private:
+    const pair<int, int>* inicio;
+    const pair<int, int>* fim;
+
+   public:
+    Vizinhos(const pair<int, int>* inicio, const pair<int, int>* fim) : inicio(inicio), fim(fim) {}
+
+    const pair<int, int>* begin() const {
+      return inicio;
+    }
+
+    const pair<int, int>* end() const {
+      return fim;
+    }
+
+    int size() const {
+      return fim - inicio;
+    }
+
+    bool empty() const {
+      return inicio == fim;
     }
+
+    const pair<int, int>& operator[](int i) const {
+      return inicio[i];
+    }
+  };
+
+  Vizinhos getVizinhos(int indiceVertice) {
+    const ListaVizinhos& lista = arestas[indiceVertice];
+    return Vizinhos(lista.begin(), lista.end());
+  }
+
+  int getGrau(int indiceVertice) {
+    return arestas[indiceVertice].size();
+  }
+
+  const string& getRotulo(int indiceVertice) {
+    return vertices[indiceVertice];
   }
 
-  vector<string> getVertices() { return vertices; }
+  int getNumVertices() {
+    return vertices.size();
+  }
 
-  vector<vector<pair<int, int>>> getArestas() { return arestas; }
+  const vector<string>& getVertices() {
+    return vertices;
+  }
+
+  ListasVizinhos getArestas() {
+    return ListasVizinhos(arestas);
+  }
 };
\ No newline at end of file
@@ -85,11 +85,18 @@ class GrafoListaAdj {
     int tamanho;
   };
 
-  // encontrar raiz
-  // pode ser com ou sem path compression
+  // encontrar raiz, com path compression: todos os grupos
+  // do caminho passam a apontar direto para a raiz
   int encontrarRaiz(Grupo* grupos, int i) {
-    if (grupos[i].pai == i) return i;
-    else return encontrarRaiz(grupos, grupos[i].pai);
+    int raiz = i;
+    while (grupos[raiz].pai != raiz) raiz = grupos[raiz].pai;
+
+    while (grupos[i].pai != raiz) {
+      int proximo = grupos[i].pai;
+      grupos[i].pai = raiz;
+      i = proximo;
+    }
+    return raiz;
   }
 
   bool mesmoGrupo(Grupo* grupos, int a, int b) {
@@ -171,11 +178,62 @@ class GrafoListaAdj {
     return mst;
   }
 
-  vector<string> getVertices() {
+  /**
+   * Visao somente-leitura de uma lista de vizinhos.
+   * Aponta diretamente para o vetor interno, entao nao ha copia nem alocacao,
+   * mas deixa de ser valida se o grafo for modificado.
+   **/
+  class Vizinhos {
+   private:
+    const pair<int, int>* inicio;
+    const pair<int, int>* fim;
+
+   public:
+    Vizinhos(const pair<int, int>* inicio, const pair<int, int>* fim) : inicio(inicio), fim(fim) {}
+
+    const pair<int, int>* begin() const {
+      return inicio;
+    }
+
+    const pair<int, int>* end() const {
+      return fim;
+    }
+
+    int size() const {
+      return fim - inicio;
+    }
+
+    bool empty() const {
+      return inicio == fim;
+    }
+
+    const pair<int, int>& operator[](int i) const {
+      return inicio[i];
+    }
+  };
+
+  Vizinhos getVizinhos(int indiceVertice) {
+    const vector<pair<int, int>>& lista = arestas[indiceVertice];
+    return Vizinhos(lista.data(), lista.data() + lista.size());
+  }
+
+  int getGrau(int indiceVertice) {
+    return arestas[indiceVertice].size();
+  }
+
+  const string& getRotulo(int indiceVertice) {
+    return vertices[indiceVertice];
+  }
+
+  int getNumVertices() {
+    return vertices.size();
+  }
+
+  const vector<string>& getVertices() {
     return vertices;
   }
 
-  vector<vector<pair<int, int>>> getArestas() {
+  const vector<vector<pair<int, int>>>& getArestas() {
     return arestas;
   }
 };
\ No newline at end of file
@@ -1,11 +1,103 @@
+#include <algorithm>
 #include <iostream>
 #include <queue>
+#include <unordered_map>
 #include <vector>
 using namespace std;
 
 #define POS_INF 1000000000
 #define NEG_INF -1000000000
 
+// destino usado para marcar uma aresta removida (tombstone)
+#define ARESTA_REMOVIDA -1
+
+// estrategias de renumeracao dos vertices usadas em reordenar()
+enum EstrategiaReordenacao { REORDENAR_RCM, REORDENAR_GRAU, REORDENAR_BFS };
+
+/**
+ * Espaco de trabalho das buscas (bfs, dfs, dijkstra, haCaminho, colorir).
+ * Quem faz muitas consultas mantem um espaco e o passa a cada busca:
+ * depois que os vetores atingem o tamanho do grafo, nenhuma consulta
+ * aloca memoria. Os visitados usam marcas de geracao: preparar() so
+ * incrementa a geracao, entao desmarcar todos os vertices custa O(1).
+ **/
+class EspacoBusca {
+ public:
+  // v foi visitado na busca atual se marcas[v] == geracao
+  vector<unsigned int> marcas;
+  unsigned int geracao;
+
+  // v ja teve sua distancia fixada pelo dijkstra atual se
+  // finalizados[v] == geracao
+  vector<unsigned int> finalizados;
+
+  // distancia e predecessor de cada vertice visitado (a origem eh seu
+  // proprio predecessor); so valem para vertices visitados na busca atual
+  vector<int> distancias;
+  vector<int> predecessores;
+
+  // fila da bfs; ao final da bfs ou do dijkstra, os vertices alcancados
+  // na ordem em que suas distancias ficaram definitivas
+  vector<int> fila;
+
+  // (vertice, posicao do proximo vizinho a examinar)
+  vector<pair<int, int>> pilha;
+
+  // heap de (distancia, vertice) do dijkstra
+  vector<pair<int, int>> heap;
+
+  EspacoBusca() : geracao(0) {}
+
+  /**
+   * Desmarca todos os vertices. Deve ser chamada antes de uma nova busca.
+   **/
+  void preparar(int numVertices) {
+    if (marcas.size() < numVertices) {
+      marcas.resize(numVertices, 0);
+      finalizados.resize(numVertices, 0);
+      distancias.resize(numVertices);
+      predecessores.resize(numVertices);
+    }
+
+    geracao++;
+    if (geracao == 0) {
+      // a geracao deu a volta: marcas antigas poderiam coincidir
+      fill(marcas.begin(), marcas.end(), 0);
+      fill(finalizados.begin(), finalizados.end(), 0);
+      geracao = 1;
+    }
+
+    fila.clear();
+    pilha.clear();
+    heap.clear();
+  }
+
+  bool visitado(int v) const {
+    return marcas[v] == geracao;
+  }
+
+  void visitar(int v) {
+    marcas[v] = geracao;
+  }
+
+  bool finalizado(int v) const {
+    return finalizados[v] == geracao;
+  }
+
+  void finalizar(int v) {
+    finalizados[v] = geracao;
+  }
+
+  /**
+   * Escreve em caminho os vertices do caminho da origem da ultima bfs ou
+   * dijkstra ate destino, seguindo os predecessores. caminho deve ter
+   * espaco para o numero de vertices do grafo.
+   * Retorna a quantidade de vertices do caminho, ou -1 se destino nao
+   * foi alcancado.
+   **/
+  int caminhoAte(int destino, int* caminho) const;
+};
+
 class GrafoListaAdj {
  private:
   vector<string> vertices;
@@ -13,53 +105,178 @@ class GrafoListaAdj {
   // first eh o indice do vertice, second eh o peso (caso o grafo seja ponderado)
   vector<vector<pair<int, int>>> arestas;
 
+  // indice de cada rotulo em vertices.
+  // Rotulos de vertices removidos nao ficam aqui
+  unordered_map<string, int> indicesVertices;
+
+  // tombstones: vertices removidos continuam ocupando seu indice
+  // ate a proxima compactacao
+  vector<bool> verticesRemovidos;
+
+  int qtdeArestas;
+  int qtdeVerticesRemovidos;
+  int qtdeArestasRemovidas;
+
+  // arestas validas que chegam em cada vertice: quando ele eh removido,
+  // elas tambem viram tombstones nas listas das origens
+  vector<int> qtdeArestasChegada;
+
+  // fracao de tombstones que dispara compactar(); 0 desativa
+  double limiarCompactacao;
+
   /**
-   * A principio nao temos nenhuma ordenacao usando os rotulos.
-   * Portanto, usaremos busca linear.
+   * Como nao temos nenhuma ordenacao usando os rotulos, mantemos
+   * uma tabela hash de rotulo para indice em vez de usar busca linear.
    **/
-  int obterIndiceVertice(string rotuloVertice) {
+  int obterIndiceVertice(const string& rotuloVertice) {
+    auto it = indicesVertices.find(rotuloVertice);
+    if (it == indicesVertices.end()) return -1;
+    return it->second;
+  }
+
+  void reconstruirIndicesVertices() {
+    indicesVertices.clear();
     for (int i = 0; i < vertices.size(); i++) {
-      if (vertices[i] == rotuloVertice) return i;
+      if (!verticesRemovidos[i]) indicesVertices.emplace(vertices[i], i);
     }
-    return -1;
   }
 
   /**
-   * O argumento indicesVerticesVisitados serve para controlar quais
-   * vertices ja foram visitados.
-   * Lembrando que DFS eh uma funcao recursiva.
+   * Uma aresta deve ser ignorada pelas navegacoes se foi removida
+   * ou se aponta para um vertice removido.
    **/
-  void dfs(string rotuloVOrigem, bool* indicesVerticesVisitados) {
-    dfs(rotuloVOrigem, indicesVerticesVisitados, POS_INF);
+  bool arestaValida(const pair<int, int>& aresta) {
+    return aresta.first != ARESTA_REMOVIDA && !verticesRemovidos[aresta.first];
+  }
+
+  void compactarSeNecessario() {
+    if (limiarCompactacao <= 0) return;
+
+    double tombstones = qtdeVerticesRemovidos + qtdeArestasRemovidas;
+    if (tombstones > limiarCompactacao * (vertices.size() + qtdeArestas)) compactar();
   }
-  void dfs(string rotuloVOrigem, bool* indicesVerticesVisitados, int cor) {
-    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
 
-    if (indiceRotuloOrigem == -1 || indicesVerticesVisitados[indiceRotuloOrigem]) return;
+  void removerAresta(int origem, int destino) {
+    for (pair<int, int>& aresta : arestas[origem]) {
+      if (aresta.first == destino) {
+        aresta.first = ARESTA_REMOVIDA;
+        qtdeArestasRemovidas++;
+        qtdeArestasChegada[destino]--;
+        compactarSeNecessario();
+        return;
+      }
+    }
+  }
 
-    indicesVerticesVisitados[indiceRotuloOrigem] = true;
-    if (cor != POS_INF) vertices[indiceRotuloOrigem] = to_string(cor);
+  /**
+   * Ordem de Cuthill-McKee: uma BFS por componente, partindo do vertice
+   * de menor grau e visitando os vizinhos em ordem crescente de grau.
+   * Invertida no final, aproxima vertices vizinhos na numeracao.
+   * As ordens supoem um grafo sem tombstones (veja reordenar).
+   **/
+  vector<int> ordemRCM() {
+    vector<int> ordem;
+    vector<bool> visitados(vertices.size(), false);
+    vector<int> porGrau(vertices.size());
+
+    for (int i = 0; i < vertices.size(); i++) porGrau[i] = i;
+    stable_sort(porGrau.begin(), porGrau.end(), [&](int a, int b) { return arestas[a].size() < arestas[b].size(); });
+
+    vector<int> vizinhos;
+    for (int inicio : porGrau) {
+      if (visitados[inicio]) continue;
+
+      int frente = ordem.size();
+      visitados[inicio] = true;
+      ordem.push_back(inicio);
+
+      while (frente < ordem.size()) {
+        int v = ordem[frente++];
+
+        vizinhos.clear();
+        for (const pair<int, int>& aresta : arestas[v]) {
+          if (!visitados[aresta.first]) {
+            visitados[aresta.first] = true;
+            vizinhos.push_back(aresta.first);
+          }
+        }
+        stable_sort(vizinhos.begin(), vizinhos.end(), [&](int a, int b) { return arestas[a].size() < arestas[b].size(); });
+        ordem.insert(ordem.end(), vizinhos.begin(), vizinhos.end());
+      }
+    }
+
+    reverse(ordem.begin(), ordem.end());
+    return ordem;
+  }
+
+  vector<int> ordemGrau() {
+    vector<int> ordem(vertices.size());
 
-    vector<pair<int, int>> vizinhos = arestas[indiceRotuloOrigem];
+    for (int i = 0; i < vertices.size(); i++) ordem[i] = i;
+    stable_sort(ordem.begin(), ordem.end(), [&](int a, int b) { return arestas[a].size() > arestas[b].size(); });
 
-    for (int i = 0; i < vizinhos.size(); i++) dfs(vertices[vizinhos[i].first], indicesVerticesVisitados, cor);
+    return ordem;
+  }
+
+  vector<int> ordemBFS() {
+    vector<int> ordem;
+    vector<bool> visitados(vertices.size(), false);
+
+    for (int inicio = 0; inicio < vertices.size(); inicio++) {
+      if (visitados[inicio]) continue;
+
+      int frente = ordem.size();
+      visitados[inicio] = true;
+      ordem.push_back(inicio);
+
+      while (frente < ordem.size()) {
+        int v = ordem[frente++];
+
+        for (const pair<int, int>& aresta : arestas[v]) {
+          if (!visitados[aresta.first]) {
+            visitados[aresta.first] = true;
+            ordem.push_back(aresta.first);
+          }
+        }
+      }
+    }
+
+    return ordem;
+  }
+
+  // usado pelas buscas que nao recebem um espaco
+  EspacoBusca espacoBusca;
+
+  // copia os predecessores da ultima busca em espacoBusca (-1 para nao alcancados)
+  void copiarPredecessores(int* predecessores) {
+    if (predecessores == NULL) return;
+
+    for (int i = 0; i < vertices.size(); i++) predecessores[i] = -1;
+    for (int v : espacoBusca.fila) predecessores[v] = espacoBusca.predecessores[v];
   }
 
  public:
+  GrafoListaAdj() : qtdeArestas(0), qtdeVerticesRemovidos(0), qtdeArestasRemovidas(0), limiarCompactacao(0) {}
+
   /**
    * Lembrem-se:
    *       1) nao podemos inserir vertices com mesmo rotulo
    *       2) toda vez que inserirmos um novo vertice, precisaremos
    *          inserir um vetor para representar as conexoes daquele
    *          vertice na lista de adjacencias
+   * O rotulo de um vertice removido pode ser inserido de novo, como um
+   * vertice novo.
    **/
   void inserirVertice(string rotuloVertice) {
     int existeRotulo = obterIndiceVertice(rotuloVertice);
 
     if (existeRotulo == -1) {
+      indicesVertices[rotuloVertice] = vertices.size();
       vertices.push_back(rotuloVertice);
       vector<pair<int, int>> v;
       arestas.push_back(v);
+      verticesRemovidos.push_back(false);
+      qtdeArestasChegada.push_back(0);
     }
   }
 
@@ -96,7 +313,119 @@ class GrafoListaAdj {
       par.second = peso;
 
       arestas[origem].push_back(par);
+      qtdeArestas++;
+      qtdeArestasChegada[destino]++;
+    }
+  }
+
+  /**
+   * Remove o vertice rotuloVertice marcando-o como tombstone em O(1)
+   * (alem da busca pelo rotulo). Suas arestas, de saida e de chegada,
+   * passam a ser ignoradas. O indice so eh liberado em compactar().
+   * As arestas de chegada continuam nas listas das origens, entao tambem
+   * contam como tombstones para o limiar de compactacao.
+   **/
+  void removerVertice(string rotuloVertice) {
+    int indice = obterIndiceVertice(rotuloVertice);
+    if (indice == -1) return;
+
+    verticesRemovidos[indice] = true;
+    qtdeVerticesRemovidos++;
+    indicesVertices.erase(rotuloVertice);
+
+    // arestas para vertices ja removidos foram contadas na remocao deles
+    for (pair<int, int>& aresta : arestas[indice]) {
+      if (arestaValida(aresta)) {
+        qtdeArestasChegada[aresta.first]--;
+        qtdeArestasRemovidas++;
+      }
+      aresta.first = ARESTA_REMOVIDA;
+    }
+
+    qtdeArestasRemovidas += qtdeArestasChegada[indice];
+    qtdeArestasChegada[indice] = 0;
+
+    compactarSeNecessario();
+  }
+
+  /**
+   * Remove uma aresta rotuloVOrigem -> rotuloVDestino, marcando seu
+   * destino como ARESTA_REMOVIDA. Se houver arestas paralelas, apenas
+   * uma delas eh removida.
+   **/
+  void removerAresta(string rotuloVOrigem, string rotuloVDestino) {
+    int origem = obterIndiceVertice(rotuloVOrigem);
+    int destino = obterIndiceVertice(rotuloVDestino);
+
+    if (origem == -1 || destino == -1) return;
+
+    removerAresta(origem, destino);
+  }
+
+  void removerArestaNaoDirecionada(string rotuloVOrigem, string rotuloVDestino) {
+    int origem = obterIndiceVertice(rotuloVOrigem);
+    int destino = obterIndiceVertice(rotuloVDestino);
+
+    if (origem == -1 || destino == -1) return;
+
+    removerAresta(origem, destino);
+    removerAresta(destino, origem);
+  }
+
+  /**
+   * Descarta vertices e arestas removidos e renumera os vertices
+   * restantes, preservando sua ordem relativa.
+   * Retorna o novo indice de cada indice antigo (-1 para removidos).
+   **/
+  vector<int> compactar() {
+    int qtdeAntiga = vertices.size();
+    vector<int> novosIndices(qtdeAntiga, -1);
+    int qtdeVertices = 0;
+
+    for (int i = 0; i < qtdeAntiga; i++) {
+      if (!verticesRemovidos[i]) novosIndices[i] = qtdeVertices++;
     }
+
+    qtdeArestas = 0;
+    qtdeArestasChegada.assign(qtdeVertices, 0);
+    for (int i = 0; i < qtdeAntiga; i++) {
+      if (verticesRemovidos[i]) continue;
+
+      vector<pair<int, int>> vizinhos;
+      for (const pair<int, int>& aresta : arestas[i]) {
+        if (arestaValida(aresta)) {
+          vizinhos.push_back(pair<int, int>(novosIndices[aresta.first], aresta.second));
+          qtdeArestasChegada[novosIndices[aresta.first]]++;
+        }
+      }
+
+      int novoIndice = novosIndices[i];
+      vertices[novoIndice].swap(vertices[i]);
+      arestas[novoIndice].swap(vizinhos);
+      qtdeArestas += arestas[novoIndice].size();
+    }
+
+    vertices.resize(qtdeVertices);
+    arestas.resize(qtdeVertices);
+    verticesRemovidos.assign(qtdeVertices, false);
+    qtdeVerticesRemovidos = 0;
+    qtdeArestasRemovidas = 0;
+    reconstruirIndicesVertices();
+
+    return novosIndices;
+  }
+
+  /**
+   * Define a fracao de tombstones (vertices e arestas removidos sobre o
+   * total) a partir da qual as remocoes chamam compactar() automaticamente.
+   * Com limiar 0, a compactacao so acontece quando chamada explicitamente.
+   **/
+  void setLimiarCompactacao(double limiar) {
+    limiarCompactacao = limiar;
+  }
+
+  bool estaRemovido(int indiceVertice) {
+    return verticesRemovidos[indiceVertice];
   }
 
   /**
@@ -128,43 +457,61 @@ class GrafoListaAdj {
    * A melhor forma de fazer isto eh reusando a funcao dfs.
    **/
   bool haCaminho(string rotuloVOrigem, string rotuloVDestino) {
-    bool* indicesVerticesVisitados = (bool*)malloc(sizeof(bool) * vertices.size());
+    return haCaminho(rotuloVOrigem, rotuloVDestino, espacoBusca);
+  }
+
+  bool haCaminho(string rotuloVOrigem, string rotuloVDestino, EspacoBusca& espaco) {
     int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
     int indiceRotuloDestino = obterIndiceVertice(rotuloVDestino);
 
-    if (indiceRotuloOrigem == indiceRotuloDestino && !saoConectados(rotuloVOrigem, rotuloVDestino)) return false;
+    if (indiceRotuloOrigem == -1 || indiceRotuloDestino == -1) return false;
+    if (indiceRotuloOrigem == indiceRotuloDestino) return saoConectados(rotuloVOrigem, rotuloVDestino);
 
-    for (int i = 0; i < vertices.size(); i++) indicesVerticesVisitados[i] = false;
+    espaco.preparar(vertices.size());
 
-    dfs(rotuloVOrigem, indicesVerticesVisitados);
-
-    return indicesVerticesVisitados[indiceRotuloDestino];
+    // a busca para assim que o destino eh descoberto
+    return !dfs(indiceRotuloOrigem, espaco, [&](int v) { return v != indiceRotuloDestino; });
   }
 
   /**
-   * Muda os rotulos do vertices dos diferentes componentes para
-   * nomes que representam cores.
+   * Escreve em componentes[i] a cor (de 1 em diante) do componente do
+   * vertice de indice i; vertices removidos recebem 0. Os rotulos nao
+   * sao alterados.
    * Dica: procura componentes partindo do vertice v0 ou v1, em ordem
    * crescente (mas voce pode usar outra ordem se desejar).
    * Retorna a quantidade de componentes.
    * A melhor forma de fazer isto e reusando a funcao dfs.
    **/
-  int colorir() {
-    bool* indicesVerticesVisitados = (bool*)malloc(sizeof(bool) * vertices.size());
+  int colorir(int* componentes) {
+    return colorir(componentes, espacoBusca);
+  }
+
+  int colorir(int* componentes, EspacoBusca& espaco) {
     int cores = 0;
 
-    for (int i = 0; i < vertices.size(); i++) indicesVerticesVisitados[i] = false;
+    espaco.preparar(vertices.size());
+    for (int i = 0; i < vertices.size(); i++) componentes[i] = 0;
 
     for (int i = 0; i < vertices.size(); i++) {
-      if (!indicesVerticesVisitados[i]) {
+      if (!verticesRemovidos[i] && !espaco.visitado(i)) {
         cores++;
-        dfs(vertices[i], indicesVerticesVisitados, cores);
+        dfs(i, espaco, [&](int v) {
+          componentes[v] = cores;
+          return true;
+        });
       }
     }
 
     return cores;
   }
 
+  int colorir() {
+    int* componentes = (int*)malloc(sizeof(int) * vertices.size());
+    int cores = colorir(componentes);
+    free(componentes);
+    return cores;
+  }
+
   /**
    * Usa a abordagem de navegacao BFS para listar as distancias
    * entre o vertice rotuloVOrigem e cada um dos demais vertices.
@@ -176,37 +523,58 @@ class GrafoListaAdj {
    * EH necessario utilizar a ED fila.
    **/
   int* bfs(string rotuloVOrigem) {
-    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
-    int* distancias = (int*)malloc(sizeof(int) * vertices.size());
-    bool* indicesVerticesVisitados = (bool*)malloc(sizeof(bool) * vertices.size());
-
-    for (int i = 0; i < vertices.size(); i++) {
-      indicesVerticesVisitados[i] = false;
-      distancias[i] = 0;
-    }
-
-    indicesVerticesVisitados[indiceRotuloOrigem] = true;
+    return bfs(rotuloVOrigem, (int*)NULL);
+  }
 
-    queue<int> fila;
+  /**
+   * Se predecessores nao for NULL, tambem escreve nele o predecessor de
+   * cada vertice na arvore da busca: a origem eh seu proprio predecessor
+   * e vertices nao alcancados recebem -1 (veja reconstruirCaminho).
+   **/
+  int* bfs(string rotuloVOrigem, int* predecessores) {
+    if (bfs(rotuloVOrigem, espacoBusca) == -1) return NULL;
 
-    fila.push(indiceRotuloOrigem);
+    int* distancias = (int*)malloc(sizeof(int) * vertices.size());
 
-    while (!fila.empty()) {
-      int indiceVerticeFrenteFila = fila.front();
+    for (int i = 0; i < vertices.size(); i++) distancias[i] = 0;
+    for (int v : espacoBusca.fila) distancias[v] = espacoBusca.distancias[v];
+    copiarPredecessores(predecessores);
 
-      vector<pair<int, int>> vizinhos = arestas[indiceVerticeFrenteFila];
+    return distancias;
+  }
 
-      for (int i = 0; i < vizinhos.size(); i++) {
-        if (!indicesVerticesVisitados[vizinhos[i].first]) {
-          fila.push(vizinhos[i].first);
-          indicesVerticesVisitados[vizinhos[i].first] = true;
-          distancias[vizinhos[i].first] = distancias[indiceVerticeFrenteFila] + 1;
+  /**
+   * bfs sem alocacao: os vertices alcancados ficam em espaco.fila, em
+   * ordem de visita, e a distancia e o predecessor de cada um em
+   * espaco.distancias e espaco.predecessores (veja espaco.caminhoAte).
+   * O custo eh proporcional ao que a busca alcanca, nao ao grafo.
+   * Retorna a quantidade de vertices alcancados, ou -1 se o vertice de
+   * origem nao existir.
+   **/
+  int bfs(string rotuloVOrigem, EspacoBusca& espaco) {
+    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
+    if (indiceRotuloOrigem == -1) return -1;
+
+    espaco.preparar(vertices.size());
+    espaco.visitar(indiceRotuloOrigem);
+    espaco.distancias[indiceRotuloOrigem] = 0;
+    espaco.predecessores[indiceRotuloOrigem] = indiceRotuloOrigem;
+    espaco.fila.push_back(indiceRotuloOrigem);
+
+    for (int frente = 0; frente < espaco.fila.size(); frente++) {
+      int indiceVerticeFrenteFila = espaco.fila[frente];
+
+      for (const pair<int, int>& aresta : getVizinhos(indiceVerticeFrenteFila)) {
+        if (arestaValida(aresta) && !espaco.visitado(aresta.first)) {
+          espaco.visitar(aresta.first);
+          espaco.distancias[aresta.first] = espaco.distancias[indiceVerticeFrenteFila] + 1;
+          espaco.predecessores[aresta.first] = indiceVerticeFrenteFila;
+          espaco.fila.push_back(aresta.first);
         }
       }
-      fila.pop();
     }
 
-    return distancias;
+    return espaco.fila.size();
   }
 
   /**
@@ -235,6 +603,8 @@ class GrafoListaAdj {
 
       for (int j = 0; j < arestas.size(); j++) {
         for (int k = 0; k < arestas[j].size(); k++) {
+          if (!arestaValida(arestas[j][k])) continue;
+
           int indiceVerticeReferencia = j;
           int indiceVerticeVizinho = arestas[j][k].first;
           int peso = arestas[j][k].second;
@@ -253,6 +623,8 @@ class GrafoListaAdj {
 
     for (int j = 0; j < arestas.size(); j++) {
       for (int k = 0; k < arestas[j].size(); k++) {
+        if (!arestaValida(arestas[j][k])) continue;
+
         int indiceVerticeReferencia = j;
         int indiceVerticeVizinho = arestas[j][k].first;
         int peso = arestas[j][k].second;
@@ -271,6 +643,7 @@ class GrafoListaAdj {
    * O Dijkstra retorna respostas incorretas caso o grafo
    * possua arestas negativas, e portanto não consegue
    * detectar ciclos negativos. Este é o aspecto negativo.
+   * Mesmo assim ele termina: cada vértice é finalizado uma vez.
    * POS_INF deve ser atribuído aos vértices inalcançáveis.
    * O aspecto positivo é sua complexidade de tempo: O(V+E).
    * Isto acontece pois, como o grafo não possui arestas negativas,
@@ -279,50 +652,266 @@ class GrafoListaAdj {
    * Ilustração: https://docs.google.com/drawings/d/1NmkJPHpcg8uVcDZ24FQiYs3uHR5n-rdm1AZwD74WiMY/edit?usp=sharing
    **/
   int* dijkstra(string rotuloVOrigem) {
-    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> fila;
-    vector<bool> indicesVerticesVisitados;
+    return dijkstra(rotuloVOrigem, (int*)NULL);
+  }
+
+  /**
+   * Se predecessores nao for NULL, tambem escreve nele o predecessor de
+   * cada vertice no caminho minimo, como em bfs.
+   **/
+  int* dijkstra(string rotuloVOrigem, int* predecessores) {
+    if (dijkstra(rotuloVOrigem, espacoBusca) == -1) return NULL;
 
-    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
     int* distancias = (int*)malloc(sizeof(int) * vertices.size());
 
+    for (int i = 0; i < vertices.size(); i++) distancias[i] = POS_INF;
+    for (int v : espacoBusca.fila) distancias[v] = espacoBusca.distancias[v];
+    copiarPredecessores(predecessores);
+
+    return distancias;
+  }
+
+  /**
+   * dijkstra sem alocacao: os vertices alcancados ficam em espaco.fila,
+   * na ordem em que suas distancias ficaram definitivas, e a distancia e
+   * o predecessor de cada um em espaco.distancias e espaco.predecessores
+   * (veja espaco.caminhoAte). O heap eh o de espaco, com remocao
+   * preguicosa: entradas com distancia maior que a atual sao descartadas.
+   * Retorna a quantidade de vertices alcancados, ou -1 se o vertice de
+   * origem nao existir.
+   **/
+  int dijkstra(string rotuloVOrigem, EspacoBusca& espaco) {
+    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
+    if (indiceRotuloOrigem == -1) return -1;
+
+    vector<pair<int, int>>& heap = espaco.heap;
+    greater<pair<int, int>> maior;
+
+    espaco.preparar(vertices.size());
+    espaco.visitar(indiceRotuloOrigem);
+    espaco.distancias[indiceRotuloOrigem] = 0;
+    espaco.predecessores[indiceRotuloOrigem] = indiceRotuloOrigem;
+    heap.push_back(pair<int, int>(0, indiceRotuloOrigem));
+
+    while (!heap.empty()) {
+      pop_heap(heap.begin(), heap.end(), maior);
+      int distancia = heap.back().first;
+      int indiceVerticeFrenteFila = heap.back().second;
+      heap.pop_back();
+
+      // entradas velhas do heap e vertices ja finalizados sao descartados:
+      // com pesos negativos, um vertice poderia voltar ao heap para sempre
+      if (distancia > espaco.distancias[indiceVerticeFrenteFila]) continue;
+      if (espaco.finalizado(indiceVerticeFrenteFila)) continue;
+      espaco.finalizar(indiceVerticeFrenteFila);
+      espaco.fila.push_back(indiceVerticeFrenteFila);
+
+      for (const pair<int, int>& aresta : getVizinhos(indiceVerticeFrenteFila)) {
+        if (!arestaValida(aresta)) continue;
+
+        int indiceVerticeVizinho = aresta.first;
+        int novaDistancia = distancia + aresta.second;
+
+        if (espaco.finalizado(indiceVerticeVizinho)) continue;
+        if (!espaco.visitado(indiceVerticeVizinho) || novaDistancia < espaco.distancias[indiceVerticeVizinho]) {
+          espaco.visitar(indiceVerticeVizinho);
+          espaco.distancias[indiceVerticeVizinho] = novaDistancia;
+          espaco.predecessores[indiceVerticeVizinho] = indiceVerticeFrenteFila;
+          heap.push_back(pair<int, int>(novaDistancia, indiceVerticeVizinho));
+          push_heap(heap.begin(), heap.end(), maior);
+        }
+      }
+    }
+
+    return espaco.fila.size();
+  }
+
+  /**
+   * Renumera os vertices para melhorar a localidade de cache: vertices
+   * vizinhos passam a ter indices proximos, entao bfs e dijkstra acessam
+   * regioes proximas de distancias e da lista de adjacencias.
+   * Estrategias:
+   *   REORDENAR_RCM   Reverse Cuthill-McKee (bom para grafos tipo malha/estradas)
+   *   REORDENAR_GRAU  grau decrescente (concentra os hubs de redes sociais)
+   *   REORDENAR_BFS   ordem de descoberta de uma BFS
+   * Os rotulos acompanham seus vertices, entao as funcoes que recebem
+   * rotulos continuam funcionando; apenas os indices mudam. Cada lista de
+   * vizinhos tambem fica ordenada pelo novo indice.
+   * Se houver tombstones, o grafo eh compactado antes.
+   * Retorna o novo indice de cada indice antigo (-1 para removidos).
+   **/
+  vector<int> reordenar(EstrategiaReordenacao estrategia) {
+    vector<int> indicesCompactados;
+    if (qtdeVerticesRemovidos + qtdeArestasRemovidas > 0) indicesCompactados = compactar();
+
+    vector<int> ordem;
+
+    if (estrategia == REORDENAR_RCM)
+      ordem = ordemRCM();
+    else if (estrategia == REORDENAR_GRAU)
+      ordem = ordemGrau();
+    else
+      ordem = ordemBFS();
+
+    vector<int> novosIndices(vertices.size());
+    for (int i = 0; i < ordem.size(); i++) novosIndices[ordem[i]] = i;
+
+    vector<string> novosVertices(vertices.size());
+    vector<vector<pair<int, int>>> novasArestas(vertices.size());
+
     for (int i = 0; i < vertices.size(); i++) {
-      distancias[i] = POS_INF;
-      indicesVerticesVisitados.push_back(false);
+      int novoIndice = novosIndices[i];
+
+      novosVertices[novoIndice].swap(vertices[i]);
+      novasArestas[novoIndice].swap(arestas[i]);
+
+      for (pair<int, int>& aresta : novasArestas[novoIndice]) aresta.first = novosIndices[aresta.first];
+      sort(novasArestas[novoIndice].begin(), novasArestas[novoIndice].end());
     }
 
-    distancias[indiceRotuloOrigem] = 0;
-    fila.push({distancias[indiceRotuloOrigem], indiceRotuloOrigem});
+    vertices.swap(novosVertices);
+    arestas.swap(novasArestas);
+    reconstruirIndicesVertices();
 
-    while (!fila.empty()) {
-      int indiceVerticeFrenteFila = fila.top().second;
+    if (indicesCompactados.empty()) return novosIndices;
 
-      fila.pop();
+    for (int& indice : indicesCompactados) {
+      if (indice != -1) indice = novosIndices[indice];
+    }
+    return indicesCompactados;
+  }
 
-      if (indicesVerticesVisitados[indiceVerticeFrenteFila])
-        continue;
-      indicesVerticesVisitados[indiceVerticeFrenteFila] = true;
+  /**
+   * Visao somente-leitura de uma lista de vizinhos.
+   * Aponta diretamente para o vetor interno, entao nao ha copia nem alocacao,
+   * mas deixa de ser valida se o grafo for modificado.
+   **/
+  class Vizinhos {
+   private:
+    const pair<int, int>* inicio;
+    const pair<int, int>* fim;
 
-      vector<pair<int, int>> vizinhosVerticeFrente = arestas[indiceVerticeFrenteFila];
+   public:
+    Vizinhos(const pair<int, int>* inicio, const pair<int, int>* fim) : inicio(inicio), fim(fim) {}
 
-      for (int i = 0; i < vizinhosVerticeFrente.size(); i++) {
-        int indiceVerticeVizinho = vizinhosVerticeFrente[i].first;
-        int peso = vizinhosVerticeFrente[i].second;
+    const pair<int, int>* begin() const {
+      return inicio;
+    }
 
-        if (distancias[indiceVerticeFrenteFila] + peso < distancias[indiceVerticeVizinho]) {
-          distancias[indiceVerticeVizinho] = distancias[indiceVerticeFrenteFila] + peso;
-          fila.push({distancias[indiceVerticeVizinho], indiceVerticeVizinho});
-        }
+    const pair<int, int>* end() const {
+      return fim;
+    }
+
+    int size() const {
+      return fim - inicio;
+    }
+
+    bool empty() const {
+      return inicio == fim;
+    }
+
+    const pair<int, int>& operator[](int i) const {
+      return inicio[i];
+    }
+  };
+
+  /**
+   * DFS iterativa a partir do vertice de indice indiceVOrigem, com pilha
+   * explicita: caminhos longos nao estouram a pilha de chamadas e cada
+   * aresta eh examinada uma unica vez.
+   * preOrdem(v) eh chamada quando v eh descoberto; se retornar false, a
+   * busca eh interrompida e dfs retorna false. posOrdem(v) eh chamada
+   * quando todos os vizinhos de v foram explorados.
+   * Os vertices ja visitados no espaco nao sao visitados de novo, o que
+   * permite chamar dfs varias vezes com o mesmo espaco (colorir); chame
+   * espaco.preparar() antes de uma busca nova.
+   **/
+  template <typename FuncaoPre, typename FuncaoPos>
+  bool dfs(int indiceVOrigem, EspacoBusca& espaco, FuncaoPre preOrdem, FuncaoPos posOrdem) {
+    if (espaco.visitado(indiceVOrigem)) return true;
+
+    espaco.visitar(indiceVOrigem);
+    if (!preOrdem(indiceVOrigem)) return false;
+    espaco.pilha.push_back(pair<int, int>(indiceVOrigem, 0));
+
+    while (!espaco.pilha.empty()) {
+      int v = espaco.pilha.back().first;
+      Vizinhos vizinhos = getVizinhos(v);
+
+      if (espaco.pilha.back().second == vizinhos.size()) {
+        espaco.pilha.pop_back();
+        posOrdem(v);
+        continue;
+      }
+
+      const pair<int, int>& aresta = vizinhos[espaco.pilha.back().second++];
+      if (!arestaValida(aresta) || espaco.visitado(aresta.first)) continue;
+
+      espaco.visitar(aresta.first);
+      if (!preOrdem(aresta.first)) {
+        espaco.pilha.clear();
+        return false;
       }
+      espaco.pilha.push_back(pair<int, int>(aresta.first, 0));
     }
 
-    return distancias;
+    return true;
+  }
+
+  template <typename FuncaoPre>
+  bool dfs(int indiceVOrigem, EspacoBusca& espaco, FuncaoPre preOrdem) {
+    return dfs(indiceVOrigem, espaco, preOrdem, [](int) {});
+  }
+
+  /**
+   * Escreve em caminho os vertices do caminho da origem ate destino,
+   * seguindo um vetor de predecessores preenchido por bfs ou dijkstra.
+   * caminho deve ter espaco para o numero de vertices do grafo.
+   * Retorna a quantidade de vertices do caminho, ou -1 se destino nao
+   * foi alcancado.
+   **/
+  static int reconstruirCaminho(const int* predecessores, int destino, int* caminho) {
+    if (predecessores[destino] == -1) return -1;
+
+    int tamanho = 1;
+    for (int v = destino; predecessores[v] != v; v = predecessores[v]) tamanho++;
+
+    int v = destino;
+    for (int i = tamanho - 1; i >= 0; i--) {
+      caminho[i] = v;
+      v = predecessores[v];
+    }
+    return tamanho;
   }
 
-  vector<string> getVertices() {
+  Vizinhos getVizinhos(int indiceVertice) {
+    const vector<pair<int, int>>& lista = arestas[indiceVertice];
+    return Vizinhos(lista.data(), lista.data() + lista.size());
+  }
+
+  int getGrau(int indiceVertice) {
+    return arestas[indiceVertice].size();
+  }
+
+  const string& getRotulo(int indiceVertice) {
+    return vertices[indiceVertice];
+  }
+
+  int getNumVertices() {
+    return vertices.size();
+  }
+
+  const vector<string>& getVertices() {
     return vertices;
   }
 
-  vector<vector<pair<int, int>>> getArestas() {
+  const vector<vector<pair<int, int>>>& getArestas() {
     return arestas;
   }
-};
\ No newline at end of file
+};
+
+// definida aqui porque usa GrafoListaAdj::reconstruirCaminho
+inline int EspacoBusca::caminhoAte(int destino, int* caminho) const {
+  if (!visitado(destino)) return -1;
+  return GrafoListaAdj::reconstruirCaminho(predecessores.data(), destino, caminho);
+}
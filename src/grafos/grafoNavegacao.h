@@ -1,219 +1,2438 @@
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
 #include <iostream>
+#include <iterator>
+#include <mutex>
 #include <queue>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 using namespace std;
 
 #define POS_INF 1000000000
 
-class GrafoListaAdj {
+// destino usado para marcar uma aresta removida (tombstone)
+#define ARESTA_REMOVIDA -1
+
+// parametros de troca de direcao da bfsDirecaoOtimizada (Beamer et al.):
+// passa para bottom-up quando a fronteira cresce e suas arestas superam
+// 1/ALFA_BFS das arestas ainda nao exploradas, e volta para top-down quando a
+// fronteira diminui e fica menor que 1/BETA_BFS dos vertices
+#define ALFA_BFS 14
+#define BETA_BFS 24
+
+// quantidade de vertices da fronteira que cada thread pega por vez na bfsParalela
+#define BLOCO_BFS_PARALELA 64
+
+// quantidade de buscas executadas juntas pela bfsMultiplasOrigens (bits de uint64_t)
+#define BUSCAS_POR_LOTE 64
+
+// componentesConexos: vizinhos de cada vertice unidos na primeira fase (Afforest)
+// e quantidade de vertices sorteados para achar o maior componente
+#define VIZINHOS_AMOSTRA 2
+#define TAMANHO_AMOSTRA 1024
+
+// quantidade de rotulos de intervalo por componente no indice de alcance
+// (cada um vem de uma DFS do DAG com outra ordem de filhos)
+#define ROTULOS_ALCANCE 2
+
+// quantidade de vertices que cada thread pega por vez em colorirVertices
+#define BLOCO_COLORACAO 256
+
+// ordem de prioridade dos vertices em colorirVertices
+enum OrdemColoracao { ORDEM_NATURAL, ORDEM_MAIOR_GRAU, ORDEM_MENOR_ULTIMO };
+
+// ordem em que um Percurso entrega os vertices
+enum TipoPercurso { PERCURSO_BFS, PERCURSO_DFS, PERCURSO_DIJKSTRA };
+
+/**
+ * Vertice entregue por um Percurso, com sua distancia da origem
+ * (arestas na BFS, profundidade na arvore da DFS, soma dos pesos no
+ * Dijkstra).
+ **/
+class VerticeAlcancado {
+ public:
+  int vertice;
+  int distancia;
+};
+
+/**
+ * Pool de rotulos internados: todos os rotulos ficam em um unico vetor de
+ * bytes e cada um eh identificado pelo seu id (a ordem em que foi internado).
+ * O id de um rotulo nunca muda, nem quando o grafo eh compactado.
+ * A busca usa uma tabela hash de enderecamento aberto que guarda apenas ids,
+ * entao o custo por rotulo eh o proprio texto, 4 bytes de offset e alguns
+ * bytes de tabela, sem uma alocacao por rotulo.
+ **/
+class PoolRotulos {
  private:
-  vector<string> vertices;
+  vector<char> bytes;
 
-  // first eh o indice do vertice, second eh o peso (caso o grafo seja ponderado)
-  vector<vector<pair<int, int>>> arestas;
+  // o rotulo de id i ocupa bytes[offsets[i]] ate bytes[offsets[i + 1]]
+  vector<uint32_t> offsets;
+
+  // ids dos rotulos; -1 indica posicao vazia. O tamanho eh potencia de 2
+  vector<int> tabela;
+
+  static uint32_t hash(string_view rotulo) {
+    uint32_t h = 2166136261u;
+    for (char c : rotulo) h = (h ^ (unsigned char)c) * 16777619u;
+    return h;
+  }
 
   /**
-   * A principio nao temos nenhuma ordenacao usando os rotulos.
-   * Portanto, usaremos busca linear.
+   * Posicao da tabela onde o rotulo esta ou onde deveria ser inserido.
    **/
-  int obterIndiceVertice(string rotuloVertice) {
-    for (int i = 0; i < vertices.size(); i++) {
-      if (vertices[i] == rotuloVertice) return i;
-    }
-    return -1;
+  int posicao(string_view rotulo) const {
+    int mascara = tabela.size() - 1;
+    int i = hash(rotulo) & mascara;
+    while (tabela[i] != -1 && obter(tabela[i]) != rotulo) i = (i + 1) & mascara;
+    return i;
+  }
+
+  void redimensionar() {
+    tabela.assign(tabela.size() * 2, -1);
+    for (int id = 0; id < size(); id++) tabela[posicao(obter(id))] = id;
   }
 
+ public:
+  PoolRotulos() : offsets(1, 0), tabela(16, -1) {}
+
   /**
-   * O argumento indicesVerticesVisitados serve para controlar quais
-   * vertices ja foram visitados.
-   * Lembrando que DFS eh uma funcao recursiva.
+   * Retorna o id do rotulo, ou -1 se ele nunca foi internado.
    **/
-  void dfs(string rotuloVOrigem, bool* indicesVerticesVisitados) {
-    dfs(rotuloVOrigem, indicesVerticesVisitados, POS_INF);
+  int buscar(string_view rotulo) const {
+    return tabela[posicao(rotulo)];
   }
-  void dfs(string rotuloVOrigem, bool* indicesVerticesVisitados, int cor) {
-    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
 
-    if (indiceRotuloOrigem == -1 || indicesVerticesVisitados[indiceRotuloOrigem]) return;
+  /**
+   * Retorna o id do rotulo, copiando-o para o pool se for novo.
+   **/
+  int internar(string_view rotulo) {
+    int i = posicao(rotulo);
+    if (tabela[i] != -1) return tabela[i];
+
+    int id = size();
+    bytes.insert(bytes.end(), rotulo.begin(), rotulo.end());
+    offsets.push_back(bytes.size());
+    tabela[i] = id;
+
+    // mantem a tabela no maximo meio cheia
+    if (2 * size() > tabela.size()) redimensionar();
+    return id;
+  }
+
+  /**
+   * A visao deixa de ser valida quando um novo rotulo eh internado.
+   **/
+  string_view obter(int id) const {
+    return string_view(bytes.data() + offsets[id], offsets[id + 1] - offsets[id]);
+  }
+
+  int size() const {
+    return offsets.size() - 1;
+  }
+
+  size_t bytesUsados() const {
+    return bytes.capacity() + offsets.capacity() * sizeof(uint32_t) + tabela.capacity() * sizeof(int);
+  }
+};
+
+/**
+ * Barreira reutilizavel: cada chamada de aguardar() bloqueia ate que
+ * todas as numThreads threads tenham chegado nela.
+ **/
+class BarreiraThreads {
+ private:
+  mutex trava;
+  condition_variable condicao;
+  int numThreads;
+  int aguardando;
+  int geracao;
+
+ public:
+  BarreiraThreads(int numThreads) : numThreads(numThreads), aguardando(0), geracao(0) {}
 
-    indicesVerticesVisitados[indiceRotuloOrigem] = true;
-    if (cor != POS_INF) vertices[indiceRotuloOrigem] = to_string(cor);
+  void aguardar() {
+    unique_lock<mutex> bloqueio(trava);
+    int geracaoAtual = geracao;
 
-    vector<pair<int, int>> vizinhos = arestas[indiceRotuloOrigem];
+    if (++aguardando == numThreads) {
+      aguardando = 0;
+      geracao++;
+      condicao.notify_all();
+      return;
+    }
 
-    for (int i = 0; i < vizinhos.size(); i++) dfs(vertices[vizinhos[i].first], indicesVerticesVisitados, cor);
+    condicao.wait(bloqueio, [&]() { return geracao != geracaoAtual; });
   }
+};
 
+/**
+ * Espaco de trabalho das buscas (bfs, dfs, haCaminho, colorir). Quem faz
+ * muitas consultas mantem um espaco e o passa a cada busca: depois que os
+ * vetores atingem o tamanho do grafo, nenhuma consulta aloca memoria.
+ * Os visitados usam marcas de geracao: preparar() so incrementa a
+ * geracao, entao desmarcar todos os vertices custa O(1).
+ **/
+class EspacoBusca {
  public:
+  // v foi visitado na busca atual se marcas[v] == geracao
+  vector<unsigned int> marcas;
+  unsigned int geracao;
+
+  // distancia (em haCaminho, o lado da busca) e predecessor de cada
+  // vertice visitado (a origem eh seu proprio predecessor); so valem
+  // para vertices visitados na busca atual
+  vector<int> distancias;
+  vector<int> predecessores;
+
+  // fila da bfs; ao final, os vertices alcancados em ordem de visita
+  vector<int> fila;
+
+  // (vertice, posicao do proximo vizinho a examinar)
+  vector<pair<int, int>> pilha;
+
+  // fronteiras da busca bidirecional de haCaminho
+  vector<int> fronteiraIda;
+  vector<int> fronteiraVolta;
+  vector<int> proxima;
+
+  // heap de (distancia, vertice) do percurso em ordem de Dijkstra
+  vector<pair<int, int>> heap;
+
+  EspacoBusca() : geracao(0) {}
+
   /**
-   * Lembrem-se:
-   *       1) nao podemos inserir vertices com mesmo rotulo
-   *       2) toda vez que inserirmos um novo vertice, precisaremos
-   *          inserir um vetor para representar as conexoes daquele
-   *          vertice na lista de adjacencias
+   * Desmarca todos os vertices. Deve ser chamada antes de uma nova busca.
    **/
-  void inserirVertice(string rotuloVertice) {
-    int existeRotulo = obterIndiceVertice(rotuloVertice);
+  void preparar(int numVertices) {
+    if (marcas.size() < numVertices) {
+      marcas.resize(numVertices, 0);
+      distancias.resize(numVertices);
+      predecessores.resize(numVertices);
+    }
 
-    if (existeRotulo == -1) {
-      vertices.push_back(rotuloVertice);
-      vector<pair<int, int>> v;
-      arestas.push_back(v);
+    geracao++;
+    if (geracao == 0) {
+      // a geracao deu a volta: marcas antigas poderiam coincidir
+      fill(marcas.begin(), marcas.end(), 0);
+      geracao = 1;
     }
+
+    fila.clear();
+    pilha.clear();
+    heap.clear();
+  }
+
+  bool visitado(int v) const {
+    return marcas[v] == geracao;
+  }
+
+  void visitar(int v) {
+    marcas[v] = geracao;
   }
 
   /**
-   * Sempre que o grafo for nao ponderado, adicionaremos o peso 1,
-   * por conveniencia.
+   * Escreve em caminho os vertices do caminho da origem da ultima bfs
+   * ate destino, seguindo os predecessores. caminho deve ter espaco para
+   * o numero de vertices do grafo.
+   * Retorna a quantidade de vertices do caminho, ou -1 se destino nao
+   * foi alcancado.
    **/
-  void inserirArestaDirecionada(string rotuloVOrigem, string rotuloVDestino) {
-    inserirArestaDirecionada(rotuloVOrigem, rotuloVDestino, 1);
+  int caminhoAte(int destino, int* caminho) const;
+};
+
+/**
+ * Numeros do indice de alcance, para ajustar o custo de construcao e
+ * memoria contra a quantidade de consultas respondidas so pelos rotulos.
+ **/
+class EstatisticasAlcance {
+ public:
+  int numComponentes;
+  int numArestasDAG;
+  size_t bytes;
+  double msConstrucao;
+  long long consultasPorRotulos;
+  long long consultasComBusca;
+
+  EstatisticasAlcance()
+      : numComponentes(0), numArestasDAG(0), bytes(0), msConstrucao(0), consultasPorRotulos(0), consultasComBusca(0) {}
+};
+
+/**
+ * Resultado de colorirVertices: cores usadas, rodadas de resolucao de
+ * conflitos, quantos vertices precisaram ser recoloridos e tempo total.
+ **/
+class EstatisticasColoracao {
+ public:
+  int numCores;
+  int rodadas;
+  long long conflitos;
+  double msExecucao;
+
+  EstatisticasColoracao() : numCores(0), rodadas(0), conflitos(0), msExecucao(0) {}
+};
+
+/**
+ * Resultado de vizinhancasKHops: os vertices a ate k arestas da origem i
+ * ficam em vertices[offsets[i]] ate vertices[offsets[i + 1] - 1], em
+ * ordem de distancia (a propria origem primeiro), com as distancias nas
+ * mesmas posicoes de distancias. Reaproveitar o resultado entre lotes
+ * evita novas alocacoes.
+ **/
+class Vizinhancas {
+ public:
+  vector<int> offsets;
+  vector<int> vertices;
+  vector<int> distancias;
+};
+
+/**
+ * DAG de componentes fortemente conexos em formato CSR: as arestas que
+ * saem do componente c vao para destinos[offsets[c]] ate
+ * destinos[offsets[c + 1] - 1], sem repeticoes.
+ **/
+class CondensacaoGrafo {
+ public:
+  int numComponentes;
+  vector<int> offsets;
+  vector<int> destinos;
+
+  CondensacaoGrafo() : numComponentes(0) {}
+};
+
+class GrafoListaAdj {
+ private:
+  PoolRotulos rotulos;
+
+  // id no pool do rotulo de cada vertice
+  vector<int> idsRotulos;
+
+  // indice do vertice que usa cada rotulo do pool (-1 se nenhum)
+  vector<int> verticesPorRotulo;
+
+  // first eh o indice do vertice, second eh o peso (caso o grafo seja ponderado)
+  vector<vector<pair<int, int>>> arestas;
+
+  // tombstones: vertices removidos continuam ocupando seu indice
+  // ate a proxima compactacao
+  vector<bool> verticesRemovidos;
+
+  int qtdeArestas;
+  int qtdeVerticesRemovidos;
+  int qtdeArestasRemovidas;
+
+  // arestas validas que chegam em cada vertice: quando ele eh removido,
+  // elas tambem viram tombstones nas listas das origens
+  vector<int> qtdeArestasChegada;
+
+  // fracao de tombstones que dispara compactar(); 0 desativa
+  double limiarCompactacao;
+
+  /**
+   * Busca o rotulo no pool e segue para o vertice que o usa.
+   * Vertices removidos sao ignorados.
+   **/
+  int obterIndiceVertice(string_view rotuloVertice) {
+    int id = rotulos.buscar(rotuloVertice);
+    if (id == -1) return -1;
+
+    int indice = verticesPorRotulo[id];
+    if (indice == -1 || verticesRemovidos[indice]) return -1;
+    return indice;
   }
 
-  void inserirArestaNaoDirecionada(string rotuloVOrigem, string rotuloVDestino) {
-    inserirArestaDirecionada(rotuloVOrigem, rotuloVDestino, 1);
-    inserirArestaDirecionada(rotuloVDestino, rotuloVOrigem, 1);
+  /**
+   * Uma aresta deve ser ignorada pelas navegacoes se foi removida
+   * ou se aponta para um vertice removido.
+   **/
+  bool arestaValida(const pair<int, int>& aresta) {
+    return aresta.first != ARESTA_REMOVIDA && !verticesRemovidos[aresta.first];
   }
 
-  void inserirArestaNaoDirecionada(string rotuloVOrigem, string rotuloVDestino, int peso) {
-    inserirArestaDirecionada(rotuloVOrigem, rotuloVDestino, peso);
-    inserirArestaDirecionada(rotuloVDestino, rotuloVOrigem, peso);
+  void compactarSeNecessario() {
+    if (limiarCompactacao <= 0) return;
+
+    double tombstones = qtdeVerticesRemovidos + qtdeArestasRemovidas;
+    if (tombstones > limiarCompactacao * (idsRotulos.size() + qtdeArestas)) compactar();
+  }
+
+  // usado pelas buscas que nao recebem um espaco
+  EspacoBusca espacoBusca;
+
+  // copia os predecessores da ultima busca em espacoBusca (-1 para nao alcancados)
+  void copiarPredecessores(int* predecessores) {
+    if (predecessores == NULL) return;
+
+    for (int i = 0; i < idsRotulos.size(); i++) predecessores[i] = -1;
+    for (int v : espacoBusca.fila) predecessores[v] = espacoBusca.predecessores[v];
   }
 
+  // espaco e resultados parciais de cada thread em vizinhancasKHops
+  vector<EspacoBusca> espacosKHops;
+  vector<vector<int>> verticesKHops;
+  vector<vector<int>> distanciasKHops;
+
   /**
-   * Inserir uma aresta entre rotuloVOrigem e rotuloVDestino com o peso
-   * especificado.
+   * BFS a partir do indice origem, usada por bfs e pelas vizinhancas
+   * k-hops. Os vertices a distancia limite nao sao expandidos, entao com
+   * limite finito so a vizinhanca eh visitada; o espaco eh desmarcado
+   * em O(1).
    **/
-  void inserirArestaDirecionada(string rotuloVOrigem, string rotuloVDestino, int peso) {
-    int origem = obterIndiceVertice(rotuloVOrigem);
-    int destino = obterIndiceVertice(rotuloVDestino);
+  int bfsIndice(int origem, EspacoBusca& espaco, int limite = INT_MAX) {
+    espaco.preparar(idsRotulos.size());
+    espaco.visitar(origem);
+    espaco.distancias[origem] = 0;
+    espaco.predecessores[origem] = origem;
+    espaco.fila.push_back(origem);
 
-    if (origem != -1 && destino != -1) {
-      pair<int, int> par;
+    for (int frente = 0; frente < espaco.fila.size(); frente++) {
+      int v = espaco.fila[frente];
+
+      // a fila esta em ordem de distancia: o resto tambem esta no limite
+      if (espaco.distancias[v] == limite) break;
+
+      for (const pair<int, int>& aresta : getVizinhos(v)) {
+        if (arestaValida(aresta) && !espaco.visitado(aresta.first)) {
+          espaco.visitar(aresta.first);
+          espaco.distancias[aresta.first] = espaco.distancias[v] + 1;
+          espaco.predecessores[aresta.first] = v;
+          espaco.fila.push_back(aresta.first);
+        }
+      }
+    }
+
+    return espaco.fila.size();
+  }
+
+  // Grupo do union-find
+  class Grupo {
+   public:
+    int pai;
+    int tamanho;
+  };
+
+  // encontrar raiz, com path compression
+  int encontrarRaiz(Grupo* grupos, int i) {
+    int raiz = i;
+    while (grupos[raiz].pai != raiz) raiz = grupos[raiz].pai;
+
+    while (grupos[i].pai != raiz) {
+      int proximo = grupos[i].pai;
+      grupos[i].pai = raiz;
+      i = proximo;
+    }
+    return raiz;
+  }
+
+  bool mesmoGrupo(Grupo* grupos, int a, int b) {
+    return encontrarRaiz(grupos, a) == encontrarRaiz(grupos, b);
+  }
+
+  void unirGrupos(Grupo* grupos, int a, int b) {
+    int raizA = encontrarRaiz(grupos, a);
+    int raizB = encontrarRaiz(grupos, b);
 
-      par.first = destino;
-      par.second = peso;
+    if (raizA == raizB) return;
 
-      arestas[origem].push_back(par);
+    if (grupos[raizA].tamanho >= grupos[raizB].tamanho) {
+      grupos[raizB].pai = raizA;
+      grupos[raizA].tamanho += grupos[raizB].tamanho;
+    } else {
+      grupos[raizA].pai = raizB;
+      grupos[raizB].tamanho += grupos[raizA].tamanho;
     }
   }
 
+  // indice de conectividade opcional: union-find mantido a cada
+  // inserirArestaNaoDirecionada; remocoes o invalidam e ele eh refeito
+  // sob demanda no proximo haCaminho
+  bool indiceConectividadeAtivo;
+  bool indiceConectividadeValido;
+  vector<Grupo> gruposConectividade;
+
+  // false a partir da primeira aresta inserida ou removida em um unico
+  // sentido; nesse caso o indice de conectividade nao pode ser usado
+  bool apenasArestasNaoDirecionadas;
+
+  // rotulos de um componente do DAG de componentes fortes: se o componente
+  // a alcanca b, entao [inicio, fim] de b esta contido no de a em todas as
+  // DFSs (pos-ordem); pre e fim[0] formam o intervalo da arvore da primeira
+  // DFS, e estar contido nele garante o alcance
+  class RotuloAlcance {
+   public:
+    int inicio[ROTULOS_ALCANCE];
+    int fim[ROTULOS_ALCANCE];
+    int pre;
+  };
+
+  // indice de alcance opcional para haCaminho; qualquer modificacao o
+  // invalida e ele eh refeito sob demanda no proximo haCaminho
+  bool indiceAlcanceAtivo;
+  bool indiceAlcanceValido;
+  vector<int> componenteAlcance;
+  CondensacaoGrafo dagAlcance;
+  vector<RotuloAlcance> rotulosAlcance;
+  vector<int> marcasAlcance;
+  int marcaAlcance;
+  vector<int> pilhaAlcance;
+  EstatisticasAlcance estatisticasAlcance;
+
+  // adjacencia reversa (arestas de chegada), montada sob demanda:
+  // as origens das arestas que chegam em v ficam em
+  // origensReversas[offsetsReversos[v]] ate origensReversas[offsetsReversos[v + 1] - 1]
+  vector<int> offsetsReversos;
+  vector<int> origensReversas;
+  bool reversoAtualizado;
+
+  // arestas inseridas depois da montagem, pelo destino: inserir nao
+  // invalida a adjacencia reversa, so a deixa com chegadas pendentes
+  vector<vector<int>> chegadasPendentes;
+  int qtdeChegadasPendentes;
+
   /**
-   * Verifica se vertice rotuloVOrigem e vertice rotuloVDestino sao
-   * conectados (vizinhos).
+   * Monta a adjacencia reversa, ignorando tombstones, e incorpora as
+   * chegadas pendentes. Remocoes e compactacao a invalidam.
    **/
-  bool saoConectados(string rotuloVOrigem, string rotuloVDestino) {
-    int origem = obterIndiceVertice(rotuloVOrigem);
-    int destino = obterIndiceVertice(rotuloVDestino);
+  void construirReverso() {
+    if (reversoAtualizado && qtdeChegadasPendentes == 0) return;
 
-    if (origem == -1 || destino == -1) return false;
+    int numVertices = idsRotulos.size();
+    offsetsReversos.assign(numVertices + 1, 0);
 
-    for (int i = 0; i < arestas.size(); i++) {
-      if (i == origem) {
-        for (int j = 0; j < arestas[i].size(); j++) {
-          if (arestas[i][j].first == destino) {
-            return true;
-          }
-        }
+    for (int v = 0; v < numVertices; v++) {
+      for (const pair<int, int>& aresta : arestas[v]) {
+        if (arestaValida(aresta)) offsetsReversos[aresta.first + 1]++;
       }
     }
+    for (int v = 0; v < numVertices; v++) offsetsReversos[v + 1] += offsetsReversos[v];
 
-    return false;
+    vector<int> cursores(offsetsReversos.begin(), offsetsReversos.end() - 1);
+    origensReversas.resize(offsetsReversos[numVertices]);
+
+    for (int v = 0; v < numVertices; v++) {
+      for (const pair<int, int>& aresta : arestas[v]) {
+        if (arestaValida(aresta)) origensReversas[cursores[aresta.first]++] = v;
+      }
+    }
+
+    chegadasPendentes.assign(numVertices, vector<int>());
+    qtdeChegadasPendentes = 0;
+    reversoAtualizado = true;
   }
 
   /**
-   * Verifica se ha algum caminho entre vertice rotuloVOrigem e
-   * vertice rotuloVDestino.
-   * A melhor forma de fazer isto eh reusando a funcao dfs.
+   * Para buscas que leem tambem as chegadas pendentes (haCaminho): so
+   * remonta quando a adjacencia foi invalidada ou quando as pendentes
+   * passam de 1/4 das arestas montadas, entao inserir e consultar
+   * alternadamente nao percorre o grafo inteiro a cada consulta.
    **/
-  bool haCaminho(string rotuloVOrigem, string rotuloVDestino) {
-    bool* indicesVerticesVisitados = (bool*)malloc(sizeof(bool) * vertices.size());
-    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
-    int indiceRotuloDestino = obterIndiceVertice(rotuloVDestino);
+  void atualizarReversoParaBusca() {
+    if (!reversoAtualizado || qtdeChegadasPendentes > origensReversas.size() / 4 + 64) construirReverso();
+  }
+
+  /**
+   * Raiz do conjunto de x no union-find compartilhado entre threads,
+   * com compressao de caminho por halving feita via compare-and-swap.
+   **/
+  static int encontrarRaizAtomica(vector<atomic<int>>& pais, int x) {
+    while (true) {
+      int pai = pais[x].load();
+      if (pai == x) return x;
 
-    if (indiceRotuloOrigem == indiceRotuloDestino && !saoConectados(rotuloVOrigem, rotuloVDestino)) return false;
+      int avo = pais[pai].load();
+      if (avo != pai) pais[x].compare_exchange_weak(pai, avo);
+      x = avo;
+    }
+  }
 
-    for (int i = 0; i < vertices.size(); i++) indicesVerticesVisitados[i] = false;
+  /**
+   * Une os conjuntos de a e b, pendurando a raiz de maior indice na de
+   * menor indice. Se outra thread mudar a raiz no meio, tenta de novo.
+   **/
+  static void unirAtomico(vector<atomic<int>>& pais, int a, int b) {
+    while (true) {
+      a = encontrarRaizAtomica(pais, a);
+      b = encontrarRaizAtomica(pais, b);
+      if (a == b) return;
+      if (a < b) swap(a, b);
 
-    dfs(rotuloVOrigem, indicesVerticesVisitados);
+      int esperado = a;
+      if (pais[a].compare_exchange_strong(esperado, b)) return;
+    }
+  }
 
-    return indicesVerticesVisitados[indiceRotuloDestino];
+  // posicao do bit 1 menos significativo (palavra != 0)
+  static int menorBit(uint64_t palavra) {
+#ifdef __GNUC__
+    return __builtin_ctzll(palavra);
+#else
+    int posicao = 0;
+    while (!(palavra & 1)) {
+      palavra >>= 1;
+      posicao++;
+    }
+    return posicao;
+#endif
   }
 
   /**
-   * Muda os rotulos do vertices dos diferentes componentes para
-   * nomes que representam cores.
-   * Dica: procura componentes partindo do vertice v0 ou v1, em ordem
-   * crescente (mas voce pode usar outra ordem se desejar).
-   * Retorna a quantidade de componentes.
-   * A melhor forma de fazer isto e reusando a funcao dfs.
+   * Ordena os vertices validos para colorirVertices; grau conta as
+   * arestas de saida e de chegada.
    **/
-  int colorir() {
-    bool* indicesVerticesVisitados = (bool*)malloc(sizeof(bool) * vertices.size());
-    int cores = 0;
+  vector<int> ordenarParaColoracao(OrdemColoracao ordem, const vector<int>& graus) {
+    int numVertices = idsRotulos.size();
+    vector<int> ordenados;
 
-    for (int i = 0; i < vertices.size(); i++) indicesVerticesVisitados[i] = false;
+    for (int v = 0; v < numVertices; v++) {
+      if (!verticesRemovidos[v]) ordenados.push_back(v);
+    }
 
-    for (int i = 0; i < vertices.size(); i++) {
-      if (!indicesVerticesVisitados[i]) {
-        cores++;
-        dfs(vertices[i], indicesVerticesVisitados, cores);
+    if (ordem == ORDEM_MAIOR_GRAU) {
+      stable_sort(ordenados.begin(), ordenados.end(), [&](int a, int b) { return graus[a] > graus[b]; });
+    } else if (ordem == ORDEM_MENOR_ULTIMO) {
+      // Matula-Beck com baldes (Batagelj-Zaversnik): retira sempre um vertice
+      // de menor grau restante; a ordem eh a inversa das retiradas
+      int maiorGrau = 0;
+      for (int v : ordenados) maiorGrau = max(maiorGrau, graus[v]);
+
+      vector<int> restantes(graus), inicioBalde(maiorGrau + 2, 0), posicoes(numVertices);
+      for (int v : ordenados) inicioBalde[graus[v] + 1]++;
+      for (int g = 0; g <= maiorGrau; g++) inicioBalde[g + 1] += inicioBalde[g];
+
+      vector<int> cursores(inicioBalde.begin(), inicioBalde.end() - 1);
+      vector<int> validos(ordenados);
+      for (int v : validos) {
+        posicoes[v] = cursores[graus[v]]++;
+        ordenados[posicoes[v]] = v;
+      }
+
+      auto retirarAresta = [&](int u, int g) {
+        if (restantes[u] <= g) return;
+
+        // troca u com o primeiro do seu balde e encolhe o balde
+        int gu = restantes[u];
+        int w = ordenados[inicioBalde[gu]];
+        swap(ordenados[posicoes[u]], ordenados[inicioBalde[gu]]);
+        swap(posicoes[u], posicoes[w]);
+        inicioBalde[gu]++;
+        restantes[u]--;
+      };
+
+      for (int i = 0; i < ordenados.size(); i++) {
+        int v = ordenados[i];
+        for (const pair<int, int>& aresta : arestas[v]) {
+          if (arestaValida(aresta)) retirarAresta(aresta.first, restantes[v]);
+        }
+        for (int k = offsetsReversos[v]; k < offsetsReversos[v + 1]; k++) retirarAresta(origensReversas[k], restantes[v]);
       }
+
+      reverse(ordenados.begin(), ordenados.end());
     }
 
-    return cores;
+    return ordenados;
+  }
+
+  int grauEntrada(int indiceVertice) {
+    return offsetsReversos[indiceVertice + 1] - offsetsReversos[indiceVertice];
+  }
+
+  void inserirAresta(int origem, int destino, int peso) {
+    pair<int, int> par;
+
+    par.first = destino;
+    par.second = peso;
+
+    arestas[origem].push_back(par);
+    qtdeArestas++;
+    qtdeArestasChegada[destino]++;
+    indiceAlcanceValido = false;
+
+    if (reversoAtualizado) {
+      chegadasPendentes[destino].push_back(origem);
+      qtdeChegadasPendentes++;
+    }
+  }
+
+  void removerAresta(int origem, int destino) {
+    for (pair<int, int>& aresta : arestas[origem]) {
+      if (aresta.first == destino) {
+        aresta.first = ARESTA_REMOVIDA;
+        qtdeArestasRemovidas++;
+        qtdeArestasChegada[destino]--;
+        reversoAtualizado = false;
+        indiceAlcanceValido = false;
+        indiceConectividadeValido = false;
+        compactarSeNecessario();
+        return;
+      }
+    }
   }
 
   /**
-   * Usa a abordagem de navegacao BFS para listar as distancias
-   * entre o vertice rotuloVOrigem e cada um dos demais vertices.
-   * A funcao BFS consegue listar a menor distancia entre um vertice
-   * e os demais se o grafo for NAO-PONDERADO.
-   * Retorna um vetor de inteiros com a quantidade de arestas
-   * (distancia) e o vertice rotuloVOrigem e cada um dos demais vertices.
-   * Nao eh uma funcao recursiva.
-   * EH necessario utilizar a ED fila.
+   * Refaz o indice de conectividade a partir das arestas validas.
    **/
-  int* bfs(string rotuloVOrigem) {
-    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
-    int* distancias = (int*)malloc(sizeof(int) * vertices.size());
-    bool* indicesVerticesVisitados = (bool*)malloc(sizeof(bool) * vertices.size());
+  void construirIndiceConectividade() {
+    gruposConectividade.resize(idsRotulos.size());
+    for (int i = 0; i < idsRotulos.size(); i++) {
+      gruposConectividade[i].pai = i;
+      gruposConectividade[i].tamanho = 1;
+    }
 
-    for (int i = 0; i < vertices.size(); i++) {
-      indicesVerticesVisitados[i] = false;
-      distancias[i] = 0;
+    for (int v = 0; v < idsRotulos.size(); v++) {
+      for (const pair<int, int>& aresta : arestas[v]) {
+        if (arestaValida(aresta)) unirGrupos(gruposConectividade.data(), v, aresta.first);
+      }
     }
 
-    indicesVerticesVisitados[indiceRotuloOrigem] = true;
+    indiceConectividadeValido = true;
+  }
+
+  /**
+   * Contrai os componentes fortes em um DAG e monta os rotulos de
+   * intervalo de cada componente.
+   **/
+  void construirIndiceAlcance() {
+    auto inicio = chrono::steady_clock::now();
+    int numVertices = idsRotulos.size();
+
+    componenteAlcance.resize(numVertices);
+    int numComponentes = componentesFortes(componenteAlcance.data(), dagAlcance);
+    const vector<int>& offsetsDAG = dagAlcance.offsets;
+    const vector<int>& destinosDAG = dagAlcance.destinos;
+
+    // rotulos: uma DFS do DAG por rotulo, cada uma percorrendo os filhos
+    // em outra ordem; as raizes saem em ordem topologica (maior numero antes)
+    rotulosAlcance.resize(numComponentes);
+    vector<char> visitados;
+    vector<pair<int, int>> pilha;
+
+    for (int r = 0; r < ROTULOS_ALCANCE; r++) {
+      visitados.assign(numComponentes, 0);
+      int contadorPre = 0, contadorPos = 0;
 
-    queue<int> fila;
+      for (int raiz = numComponentes - 1; raiz >= 0; raiz--) {
+        if (visitados[raiz]) continue;
 
-    fila.push(indiceRotuloOrigem);
+        visitados[raiz] = 1;
+        rotulosAlcance[raiz].inicio[r] = INT_MAX;
+        if (r == 0) rotulosAlcance[raiz].pre = contadorPre++;
+        pilha.push_back(pair<int, int>(raiz, 0));
 
-    while (!fila.empty()) {
-      int indiceVerticeFrenteFila = fila.front();
+        while (!pilha.empty()) {
+          int c = pilha.back().first;
+          int k = pilha.back().second;
+          int grau = offsetsDAG[c + 1] - offsetsDAG[c];
 
-      vector<pair<int, int>> vizinhos = arestas[indiceVerticeFrenteFila];
+          if (k < grau) {
+            pilha.back().second++;
+            int d = destinosDAG[offsetsDAG[c] + (r % 2 == 0 ? k : grau - 1 - k)];
 
-      for (int i = 0; i < vizinhos.size(); i++) {
-        if (!indicesVerticesVisitados[vizinhos[i].first]) {
-          fila.push(vizinhos[i].first);
-          indicesVerticesVisitados[vizinhos[i].first] = true;
-          distancias[vizinhos[i].first] = distancias[indiceVerticeFrenteFila] + 1;
+            if (visitados[d]) {
+              rotulosAlcance[c].inicio[r] = min(rotulosAlcance[c].inicio[r], rotulosAlcance[d].inicio[r]);
+            } else {
+              visitados[d] = 1;
+              rotulosAlcance[d].inicio[r] = INT_MAX;
+              if (r == 0) rotulosAlcance[d].pre = contadorPre++;
+              pilha.push_back(pair<int, int>(d, 0));
+            }
+            continue;
+          }
+
+          pilha.pop_back();
+          RotuloAlcance& rotulo = rotulosAlcance[c];
+          rotulo.fim[r] = contadorPos++;
+          rotulo.inicio[r] = min(rotulo.inicio[r], rotulo.fim[r]);
+          if (!pilha.empty()) {
+            int pai = pilha.back().first;
+            rotulosAlcance[pai].inicio[r] = min(rotulosAlcance[pai].inicio[r], rotulo.inicio[r]);
+          }
         }
       }
-      fila.pop();
     }
 
-    return distancias;
+    marcasAlcance.assign(numComponentes, 0);
+    marcaAlcance = 0;
+    indiceAlcanceValido = true;
+
+    estatisticasAlcance.numComponentes = numComponentes;
+    estatisticasAlcance.numArestasDAG = destinosDAG.size();
+    estatisticasAlcance.bytes = sizeof(int) * (componenteAlcance.size() + offsetsDAG.size() + destinosDAG.size() +
+                                               marcasAlcance.size()) +
+                                sizeof(RotuloAlcance) * rotulosAlcance.size();
+    estatisticasAlcance.msConstrucao =
+        chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
   }
 
-  vector<string> getVertices() {
-    return vertices;
+  // false se b certamente nao eh alcancado a partir de a
+  bool intervalosContidos(int a, int b) {
+    const RotuloAlcance& rotuloA = rotulosAlcance[a];
+    const RotuloAlcance& rotuloB = rotulosAlcance[b];
+
+    for (int r = 0; r < ROTULOS_ALCANCE; r++) {
+      if (rotuloB.inicio[r] < rotuloA.inicio[r] || rotuloB.fim[r] > rotuloA.fim[r]) return false;
+    }
+    return true;
   }
 
-  vector<vector<pair<int, int>>> getArestas() {
-    return arestas;
+  /**
+   * Responde se origem alcanca destino (indices distintos) pelo indice.
+   * A maior parte das consultas termina nos rotulos; as demais fazem uma
+   * DFS no DAG que so entra em componentes cujos intervalos contem o
+   * do destino.
+   **/
+  bool alcancaPeloIndice(int origem, int destino) {
+    int a = componenteAlcance[origem];
+    int b = componenteAlcance[destino];
+
+    if (a == b) {
+      estatisticasAlcance.consultasPorRotulos++;
+      return true;
+    }
+
+    // b vem antes de a na ordem topologica, ou algum intervalo exclui b
+    if (a < b || !intervalosContidos(a, b)) {
+      estatisticasAlcance.consultasPorRotulos++;
+      return false;
+    }
+
+    // b descende de a na arvore da primeira DFS
+    if (rotulosAlcance[a].pre <= rotulosAlcance[b].pre && rotulosAlcance[b].fim[0] <= rotulosAlcance[a].fim[0]) {
+      estatisticasAlcance.consultasPorRotulos++;
+      return true;
+    }
+
+    estatisticasAlcance.consultasComBusca++;
+    if (marcaAlcance == INT_MAX) {
+      fill(marcasAlcance.begin(), marcasAlcance.end(), 0);
+      marcaAlcance = 0;
+    }
+    marcaAlcance++;
+
+    pilhaAlcance.clear();
+    pilhaAlcance.push_back(a);
+    marcasAlcance[a] = marcaAlcance;
+
+    while (!pilhaAlcance.empty()) {
+      int c = pilhaAlcance.back();
+      pilhaAlcance.pop_back();
+
+      for (int k = dagAlcance.offsets[c]; k < dagAlcance.offsets[c + 1]; k++) {
+        int d = dagAlcance.destinos[k];
+        if (d == b) return true;
+        if (d < b || marcasAlcance[d] == marcaAlcance || !intervalosContidos(d, b)) continue;
+
+        marcasAlcance[d] = marcaAlcance;
+        pilhaAlcance.push_back(d);
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Executa funcao(t) para t = 0 .. numThreads - 1, cada uma em uma thread.
+   **/
+  template <typename Funcao>
+  static void executarEmParalelo(int numThreads, Funcao funcao) {
+    if (numThreads <= 1) {
+      funcao(0);
+      return;
+    }
+
+    vector<thread> threads;
+    for (int t = 0; t < numThreads; t++) threads.emplace_back(funcao, t);
+    for (int t = 0; t < numThreads; t++) threads[t].join();
   }
-};
\ No newline at end of file
+
+ public:
+  GrafoListaAdj()
+      : qtdeArestas(0),
+        qtdeVerticesRemovidos(0),
+        qtdeArestasRemovidas(0),
+        limiarCompactacao(0),
+        indiceConectividadeAtivo(false),
+        indiceConectividadeValido(false),
+        apenasArestasNaoDirecionadas(true),
+        indiceAlcanceAtivo(false),
+        indiceAlcanceValido(false),
+        marcaAlcance(0),
+        reversoAtualizado(false),
+        qtdeChegadasPendentes(0) {}
+
+  /**
+   * Lembrem-se:
+   *       1) nao podemos inserir vertices com mesmo rotulo
+   *       2) toda vez que inserirmos um novo vertice, precisaremos
+   *          inserir um vetor para representar as conexoes daquele
+   *          vertice na lista de adjacencias
+   * O rotulo de um vertice removido eh reaproveitado (mesmo id no pool).
+   **/
+  void inserirVertice(string rotuloVertice) {
+    int existeRotulo = obterIndiceVertice(rotuloVertice);
+
+    if (existeRotulo == -1) {
+      int id = rotulos.internar(rotuloVertice);
+      verticesPorRotulo.resize(rotulos.size(), -1);
+      verticesPorRotulo[id] = idsRotulos.size();
+
+      idsRotulos.push_back(id);
+      vector<pair<int, int>> v;
+      arestas.push_back(v);
+      verticesRemovidos.push_back(false);
+      qtdeArestasChegada.push_back(0);
+      indiceAlcanceValido = false;
+
+      // o vertice novo entra na adjacencia reversa sem arestas de chegada
+      if (reversoAtualizado) {
+        offsetsReversos.push_back(offsetsReversos.back());
+        chegadasPendentes.push_back(vector<int>());
+      }
+
+      if (indiceConectividadeValido) {
+        Grupo grupo;
+        grupo.pai = gruposConectividade.size();
+        grupo.tamanho = 1;
+        gruposConectividade.push_back(grupo);
+      }
+    }
+  }
+
+  /**
+   * Sempre que o grafo for nao ponderado, adicionaremos o peso 1,
+   * por conveniencia.
+   **/
+  void inserirArestaDirecionada(string rotuloVOrigem, string rotuloVDestino) {
+    inserirArestaDirecionada(rotuloVOrigem, rotuloVDestino, 1);
+  }
+
+  void inserirArestaNaoDirecionada(string rotuloVOrigem, string rotuloVDestino) {
+    inserirArestaNaoDirecionada(rotuloVOrigem, rotuloVDestino, 1);
+  }
+
+  /**
+   * Se o indice de conectividade estiver valido, os dois grupos
+   * sao unidos aqui mesmo.
+   **/
+  void inserirArestaNaoDirecionada(string rotuloVOrigem, string rotuloVDestino, int peso) {
+    int origem = obterIndiceVertice(rotuloVOrigem);
+    int destino = obterIndiceVertice(rotuloVDestino);
+
+    if (origem == -1 || destino == -1) return;
+
+    inserirAresta(origem, destino, peso);
+    inserirAresta(destino, origem, peso);
+
+    if (indiceConectividadeValido) unirGrupos(gruposConectividade.data(), origem, destino);
+  }
+
+  /**
+   * Inserir uma aresta entre rotuloVOrigem e rotuloVDestino com o peso
+   * especificado.
+   **/
+  void inserirArestaDirecionada(string rotuloVOrigem, string rotuloVDestino, int peso) {
+    int origem = obterIndiceVertice(rotuloVOrigem);
+    int destino = obterIndiceVertice(rotuloVDestino);
+
+    if (origem != -1 && destino != -1) {
+      inserirAresta(origem, destino, peso);
+      apenasArestasNaoDirecionadas = false;
+    }
+  }
+
+  /**
+   * Verifica se vertice rotuloVOrigem e vertice rotuloVDestino sao
+   * conectados (vizinhos).
+   **/
+  bool saoConectados(string rotuloVOrigem, string rotuloVDestino) {
+    int origem = obterIndiceVertice(rotuloVOrigem);
+    int destino = obterIndiceVertice(rotuloVDestino);
+
+    if (origem == -1 || destino == -1) return false;
+
+    for (int i = 0; i < arestas.size(); i++) {
+      if (i == origem) {
+        for (int j = 0; j < arestas[i].size(); j++) {
+          if (arestas[i][j].first == destino) {
+            return true;
+          }
+        }
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Remove o vertice rotuloVertice marcando-o como tombstone em O(1)
+   * (alem da busca pelo rotulo). Suas arestas, de saida e de chegada,
+   * passam a ser ignoradas. O indice so eh liberado em compactar().
+   * As arestas de chegada continuam nas listas das origens, entao tambem
+   * contam como tombstones para o limiar de compactacao.
+   **/
+  void removerVertice(string rotuloVertice) {
+    int indice = obterIndiceVertice(rotuloVertice);
+    if (indice == -1) return;
+
+    verticesRemovidos[indice] = true;
+    qtdeVerticesRemovidos++;
+    reversoAtualizado = false;
+    indiceAlcanceValido = false;
+    indiceConectividadeValido = false;
+
+    // arestas para vertices ja removidos foram contadas na remocao deles
+    for (pair<int, int>& aresta : arestas[indice]) {
+      if (arestaValida(aresta)) {
+        qtdeArestasChegada[aresta.first]--;
+        qtdeArestasRemovidas++;
+      }
+      aresta.first = ARESTA_REMOVIDA;
+    }
+
+    qtdeArestasRemovidas += qtdeArestasChegada[indice];
+    qtdeArestasChegada[indice] = 0;
+
+    compactarSeNecessario();
+  }
+
+  /**
+   * Remove uma aresta rotuloVOrigem -> rotuloVDestino, marcando seu
+   * destino como ARESTA_REMOVIDA. Se houver arestas paralelas, apenas
+   * uma delas eh removida.
+   **/
+  void removerAresta(string rotuloVOrigem, string rotuloVDestino) {
+    int origem = obterIndiceVertice(rotuloVOrigem);
+    int destino = obterIndiceVertice(rotuloVDestino);
+
+    if (origem == -1 || destino == -1) return;
+
+    apenasArestasNaoDirecionadas = false;
+    removerAresta(origem, destino);
+  }
+
+  void removerArestaNaoDirecionada(string rotuloVOrigem, string rotuloVDestino) {
+    int origem = obterIndiceVertice(rotuloVOrigem);
+    int destino = obterIndiceVertice(rotuloVDestino);
+
+    if (origem == -1 || destino == -1) return;
+
+    removerAresta(origem, destino);
+    removerAresta(destino, origem);
+  }
+
+  /**
+   * Descarta vertices e arestas removidos e renumera os vertices
+   * restantes, preservando sua ordem relativa.
+   * Retorna o novo indice de cada indice antigo (-1 para removidos).
+   **/
+  vector<int> compactar() {
+    int qtdeAntiga = idsRotulos.size();
+    vector<int> novosIndices(qtdeAntiga, -1);
+    int qtdeVertices = 0;
+
+    for (int i = 0; i < qtdeAntiga; i++) {
+      if (!verticesRemovidos[i]) novosIndices[i] = qtdeVertices++;
+    }
+
+    // os rotulos continuam no pool com o mesmo id; so muda o vertice dono
+    for (int i = 0; i < qtdeAntiga; i++) {
+      int id = idsRotulos[i];
+      if (verticesPorRotulo[id] == i) verticesPorRotulo[id] = novosIndices[i];
+    }
+
+    qtdeArestas = 0;
+    qtdeArestasChegada.assign(qtdeVertices, 0);
+    for (int i = 0; i < qtdeAntiga; i++) {
+      if (verticesRemovidos[i]) continue;
+
+      vector<pair<int, int>> vizinhos;
+      for (const pair<int, int>& aresta : arestas[i]) {
+        if (arestaValida(aresta)) {
+          vizinhos.push_back(pair<int, int>(novosIndices[aresta.first], aresta.second));
+          qtdeArestasChegada[novosIndices[aresta.first]]++;
+        }
+      }
+
+      int novoIndice = novosIndices[i];
+      idsRotulos[novoIndice] = idsRotulos[i];
+      arestas[novoIndice].swap(vizinhos);
+      qtdeArestas += arestas[novoIndice].size();
+    }
+
+    idsRotulos.resize(qtdeVertices);
+    arestas.resize(qtdeVertices);
+    verticesRemovidos.assign(qtdeVertices, false);
+    qtdeVerticesRemovidos = 0;
+    qtdeArestasRemovidas = 0;
+    reversoAtualizado = false;
+    indiceAlcanceValido = false;
+    indiceConectividadeValido = false;
+
+    return novosIndices;
+  }
+
+  /**
+   * Define a fracao de tombstones (vertices e arestas removidos sobre o
+   * total) a partir da qual as remocoes chamam compactar() automaticamente.
+   * Com limiar 0, a compactacao so acontece quando chamada explicitamente.
+   **/
+  void setLimiarCompactacao(double limiar) {
+    limiarCompactacao = limiar;
+  }
+
+  bool estaRemovido(int indiceVertice) {
+    return verticesRemovidos[indiceVertice];
+  }
+
+  /**
+   * Ativa o indice de conectividade: enquanto o grafo so tiver arestas
+   * nao direcionadas, haCaminho passa a responder consultando um
+   * union-find, em tempo quase constante amortizado. Inserir vertices e
+   * arestas nao direcionadas atualiza o indice; remocoes e compactacao o
+   * invalidam, e ele eh refeito no proximo haCaminho. Com alguma aresta
+   * direcionada, haCaminho volta a usar a busca bidirecional.
+   **/
+  void ativarIndiceConectividade() {
+    indiceConectividadeAtivo = true;
+  }
+
+  void desativarIndiceConectividade() {
+    indiceConectividadeAtivo = false;
+    indiceConectividadeValido = false;
+    gruposConectividade.clear();
+  }
+
+  /**
+   * Ativa o indice de alcance, para haCaminho em grafos direcionados
+   * que mudam pouco. Na primeira consulta os componentes fortemente
+   * conexos sao contraidos em um DAG e cada componente recebe
+   * ROTULOS_ALCANCE intervalos de pos-ordem (GRAIL) e o intervalo da
+   * arvore de DFS; a maioria das consultas eh respondida so com eles, e
+   * as demais fazem uma DFS podada no DAG. Qualquer modificacao do grafo
+   * invalida o indice, que eh refeito na consulta seguinte.
+   **/
+  void ativarIndiceAlcance() {
+    indiceAlcanceAtivo = true;
+  }
+
+  void desativarIndiceAlcance() {
+    indiceAlcanceAtivo = false;
+    indiceAlcanceValido = false;
+    componenteAlcance.clear();
+    dagAlcance = CondensacaoGrafo();
+    rotulosAlcance.clear();
+    marcasAlcance.clear();
+  }
+
+  /**
+   * Tempo de construcao (ms), memoria (bytes) e tamanho do DAG da ultima
+   * construcao do indice de alcance, e quantas consultas foram respondidas
+   * so pelos rotulos ou precisaram de busca desde a ativacao.
+   * Se o indice estiver ativo e desatualizado, ele eh refeito antes.
+   **/
+  EstatisticasAlcance getEstatisticasAlcance() {
+    if (indiceAlcanceAtivo && !indiceAlcanceValido) construirIndiceAlcance();
+    return estatisticasAlcance;
+  }
+
+  /**
+   * Verifica se ha algum caminho entre vertice rotuloVOrigem e
+   * vertice rotuloVDestino.
+   * Usa uma BFS bidirecional: uma busca cresce a partir da origem pelas
+   * arestas de saida e outra a partir do destino pelas arestas de chegada
+   * (adjacencia reversa), sempre expandindo a menor fronteira. A resposta
+   * sai assim que as duas buscas se encontram, entao destinos proximos
+   * sao achados sem explorar o componente inteiro.
+   * Se todas as arestas forem nao direcionadas, as arestas de chegada sao
+   * as proprias listas de vizinhos; senao, a adjacencia reversa recebe as
+   * insercoes incrementalmente e nao eh remontada a cada consulta.
+   * Com o indice de conectividade (grafo so com arestas nao direcionadas)
+   * ou o indice de alcance ativos, a resposta vem do indice.
+   **/
+  bool haCaminho(string rotuloVOrigem, string rotuloVDestino) {
+    return haCaminho(rotuloVOrigem, rotuloVDestino, espacoBusca);
+  }
+
+  bool haCaminho(string rotuloVOrigem, string rotuloVDestino, EspacoBusca& espaco) {
+    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
+    int indiceRotuloDestino = obterIndiceVertice(rotuloVDestino);
+
+    if (indiceRotuloOrigem == -1 || indiceRotuloDestino == -1) return false;
+    if (indiceRotuloOrigem == indiceRotuloDestino) return saoConectados(rotuloVOrigem, rotuloVDestino);
+
+    if (indiceConectividadeAtivo && apenasArestasNaoDirecionadas) {
+      if (!indiceConectividadeValido) construirIndiceConectividade();
+      return mesmoGrupo(gruposConectividade.data(), indiceRotuloOrigem, indiceRotuloDestino);
+    }
+
+    if (indiceAlcanceAtivo) {
+      if (!indiceAlcanceValido) construirIndiceAlcance();
+      return alcancaPeloIndice(indiceRotuloOrigem, indiceRotuloDestino);
+    }
+
+    bool usarReverso = !apenasArestasNaoDirecionadas;
+    if (usarReverso) atualizarReversoParaBusca();
+    espaco.preparar(idsRotulos.size());
+
+    // distancias guarda o lado: 1 alcancado pela origem, 2 alcanca o destino
+    espaco.visitar(indiceRotuloOrigem);
+    espaco.distancias[indiceRotuloOrigem] = 1;
+    espaco.visitar(indiceRotuloDestino);
+    espaco.distancias[indiceRotuloDestino] = 2;
+
+    vector<int>& fronteiraIda = espaco.fronteiraIda;
+    vector<int>& fronteiraVolta = espaco.fronteiraVolta;
+    vector<int>& proxima = espaco.proxima;
+    fronteiraIda.assign(1, indiceRotuloOrigem);
+    fronteiraVolta.assign(1, indiceRotuloDestino);
+
+    bool encontrou = false;
+
+    while (!encontrou && !fronteiraIda.empty() && !fronteiraVolta.empty()) {
+      bool ida = fronteiraIda.size() <= fronteiraVolta.size();
+      vector<int>& fronteira = ida ? fronteiraIda : fronteiraVolta;
+      int lado = ida ? 1 : 2;
+      proxima.clear();
+
+      for (int i = 0; i < fronteira.size() && !encontrou; i++) {
+        int v = fronteira[i];
+
+        auto visitar = [&](int w) {
+          if (!espaco.visitado(w)) {
+            espaco.visitar(w);
+            espaco.distancias[w] = lado;
+            proxima.push_back(w);
+          } else if (espaco.distancias[w] != lado) {
+            encontrou = true;
+          }
+        };
+
+        if (ida || !usarReverso) {
+          for (const pair<int, int>& aresta : getVizinhos(v)) {
+            if (arestaValida(aresta)) visitar(aresta.first);
+          }
+        } else {
+          for (int k = offsetsReversos[v]; k < offsetsReversos[v + 1]; k++) visitar(origensReversas[k]);
+          for (int origem : chegadasPendentes[v]) visitar(origem);
+        }
+      }
+
+      fronteira.swap(proxima);
+    }
+
+    return encontrou;
+  }
+
+  /**
+   * Escreve em componentes[i] a cor (de 1 em diante) do componente do
+   * vertice de indice i; vertices removidos recebem 0. Os rotulos nao
+   * sao alterados. Em grafos direcionados, use componentesFortes.
+   * Dica: procura componentes partindo do vertice v0 ou v1, em ordem
+   * crescente (mas voce pode usar outra ordem se desejar).
+   * Retorna a quantidade de componentes.
+   * A melhor forma de fazer isto e reusando a funcao dfs.
+   **/
+  int colorir(int* componentes) {
+    return colorir(componentes, espacoBusca);
+  }
+
+  int colorir(int* componentes, EspacoBusca& espaco) {
+    int cores = 0;
+
+    espaco.preparar(idsRotulos.size());
+    for (int i = 0; i < idsRotulos.size(); i++) componentes[i] = 0;
+
+    for (int i = 0; i < idsRotulos.size(); i++) {
+      if (!espaco.visitado(i) && !verticesRemovidos[i]) {
+        cores++;
+        dfs(i, espaco, [&](int v) {
+          componentes[v] = cores;
+          return true;
+        });
+      }
+    }
+
+    return cores;
+  }
+
+  int colorir() {
+    int* componentes = (int*)malloc(sizeof(int) * idsRotulos.size());
+    int cores = colorir(componentes);
+    free(componentes);
+    return cores;
+  }
+
+  /**
+   * Componentes conexos calculados em paralelo com um union-find sem travas
+   * (Afforest): primeiro cada vertice eh unido aos seus VIZINHOS_AMOSTRA
+   * primeiros vizinhos; em seguida, uma amostra de vertices indica o maior
+   * componente ja formado, e os vertices que estao nele nao precisam
+   * examinar o restante das suas arestas.
+   * As arestas valem nos dois sentidos (componentes fracamente conexos);
+   * para grafos nao direcionados o resultado eh igual ao de colorir(int*):
+   * componentId[i] recebe o componente (de 1 em diante, na ordem do menor
+   * vertice de cada um) e vertices removidos recebem 0. Os rotulos nao
+   * sao alterados.
+   * Retorna a quantidade de componentes.
+   **/
+  int componentesConexos(int* componentId, int numThreads) {
+    int numVertices = idsRotulos.size();
+    if (numThreads < 1) numThreads = 1;
+
+    construirReverso();
+
+    vector<atomic<int>> pais(numVertices);
+    for (int v = 0; v < numVertices; v++) pais[v].store(v, memory_order_relaxed);
+
+    // fase 1: primeiros vizinhos de cada vertice
+    executarEmParalelo(numThreads, [&](int t) {
+      for (int v = t; v < numVertices; v += numThreads) {
+        int usados = 0;
+        for (const pair<int, int>& aresta : getVizinhos(v)) {
+          if (usados == VIZINHOS_AMOSTRA) break;
+          if (!arestaValida(aresta)) continue;
+          unirAtomico(pais, v, aresta.first);
+          usados++;
+        }
+      }
+    });
+
+    // fase 2: o componente mais frequente em uma amostra
+    vector<int> raizes(numVertices);
+    executarEmParalelo(numThreads, [&](int t) {
+      for (int v = t; v < numVertices; v += numThreads) raizes[v] = encontrarRaizAtomica(pais, v);
+    });
+
+    int maiorComponente = -1;
+    if (numVertices > 0) {
+      unordered_map<int, int> frequencias;
+      unsigned int semente = 12345;
+      int maiorFrequencia = 0;
+
+      for (int k = 0; k < TAMANHO_AMOSTRA; k++) {
+        semente = semente * 1103515245 + 12345;
+        int raiz = raizes[(semente >> 8) % numVertices];
+        if (++frequencias[raiz] > maiorFrequencia) {
+          maiorFrequencia = frequencias[raiz];
+          maiorComponente = raiz;
+        }
+      }
+    }
+
+    // fase 3: vertices fora do maior componente examinam as demais arestas.
+    // Como o grafo pode ser direcionado, tambem examinam as de chegada: uma
+    // aresta que sai do maior componente eh vista pelo outro extremo
+    executarEmParalelo(numThreads, [&](int t) {
+      for (int v = t; v < numVertices; v += numThreads) {
+        if (verticesRemovidos[v] || raizes[v] == maiorComponente) continue;
+
+        int usados = 0;
+        for (const pair<int, int>& aresta : getVizinhos(v)) {
+          if (!arestaValida(aresta)) continue;
+          if (usados++ >= VIZINHOS_AMOSTRA) unirAtomico(pais, v, aresta.first);
+        }
+        for (int k = offsetsReversos[v]; k < offsetsReversos[v + 1]; k++) unirAtomico(pais, v, origensReversas[k]);
+      }
+    });
+
+    // a raiz de cada conjunto eh o seu menor vertice, entao, percorrendo em
+    // ordem crescente, cada componente eh numerado ao encontrarmos sua raiz
+    int componentes = 0;
+    for (int v = 0; v < numVertices; v++) {
+      if (verticesRemovidos[v]) {
+        componentId[v] = 0;
+        continue;
+      }
+
+      int raiz = encontrarRaizAtomica(pais, v);
+      componentId[v] = raiz == v ? ++componentes : componentId[raiz];
+    }
+
+    return componentes;
+  }
+
+  /**
+   * Componentes fortemente conexos (arestas direcionadas valem so no seu
+   * sentido), pela variante de Pearce do algoritmo de Tarjan com pilha
+   * explicita: tempo linear, sem limite de profundidade, e o proprio
+   * componentId guarda os indices da DFS, entao a memoria extra eh um
+   * bit por vertice mais as pilhas.
+   * componentId[i] recebe o componente do vertice de indice i, de 0 em
+   * diante, em ordem topologica reversa: toda aresta entre componentes
+   * vai de um numero maior para um menor. Vertices removidos recebem -1.
+   * Retorna a quantidade de componentes.
+   **/
+  int componentesFortes(int* componentId) {
+    int numVertices = idsRotulos.size();
+    vector<bool> raizes(numVertices, false);
+    vector<int> pilhaComponente;
+    vector<pair<int, int>> pilha;  // vertice e proxima aresta a examinar
+
+    // indices da DFS crescem a partir de 1; componentes concluidos recebem
+    // numeros decrescentes a partir de numVertices - 1, sempre maiores que
+    // os indices ainda em uso
+    int indice = 1, componente = numVertices - 1;
+
+    for (int v = 0; v < numVertices; v++) componentId[v] = 0;
+
+    for (int origem = 0; origem < numVertices; origem++) {
+      if (verticesRemovidos[origem] || componentId[origem] != 0) continue;
+
+      componentId[origem] = indice++;
+      raizes[origem] = true;
+      pilha.push_back(pair<int, int>(origem, 0));
+
+      while (!pilha.empty()) {
+        int v = pilha.back().first;
+        int k = pilha.back().second;
+
+        if (k < arestas[v].size()) {
+          const pair<int, int>& aresta = arestas[v][k];
+          if (!arestaValida(aresta)) {
+            pilha.back().second++;
+            continue;
+          }
+
+          int w = aresta.first;
+          if (componentId[w] == 0) {
+            // a aresta eh examinada de novo quando w terminar
+            componentId[w] = indice++;
+            raizes[w] = true;
+            pilha.push_back(pair<int, int>(w, 0));
+            continue;
+          }
+
+          pilha.back().second++;
+          if (componentId[w] < componentId[v]) {
+            componentId[v] = componentId[w];
+            raizes[v] = false;
+          }
+          continue;
+        }
+
+        pilha.pop_back();
+
+        if (!raizes[v]) {
+          pilhaComponente.push_back(v);
+          continue;
+        }
+
+        indice--;
+        while (!pilhaComponente.empty() && componentId[v] <= componentId[pilhaComponente.back()]) {
+          componentId[pilhaComponente.back()] = componente;
+          pilhaComponente.pop_back();
+          indice--;
+        }
+        componentId[v] = componente--;
+      }
+    }
+
+    for (int v = 0; v < numVertices; v++) {
+      componentId[v] = verticesRemovidos[v] ? -1 : numVertices - 1 - componentId[v];
+    }
+
+    return numVertices - 1 - componente;
+  }
+
+  /**
+   * Coloracao propria dos vertices: vizinhos (por arestas em qualquer
+   * sentido) nunca recebem a mesma cor. Usa a coloracao especulativa de
+   * Gebremedhin-Manne: em cada rodada as threads dao a cada vertice
+   * pendente a menor cor livre entre os vizinhos, sem sincronizar; depois
+   * cada conflito eh desfeito recolorindo, na rodada seguinte, o vertice
+   * que vem depois na ordem. Com uma thread o resultado eh o guloso na
+   * ordem escolhida:
+   *   ORDEM_NATURAL       indice dos vertices
+   *   ORDEM_MAIOR_GRAU    grau decrescente (largest-first)
+   *   ORDEM_MENOR_ULTIMO  smallest-last, usa no maximo degeneracao + 1 cores
+   * cores[i] recebe a cor (de 0 em diante) do vertice de indice i; vertices
+   * removidos recebem -1. Diferente de colorir, que rotula componentes.
+   * Retorna a quantidade de cores; estatisticas, se informado, recebe
+   * tambem as rodadas, os conflitos e o tempo.
+   **/
+  int colorirVertices(int* cores, int numThreads, OrdemColoracao ordem = ORDEM_NATURAL,
+                      EstatisticasColoracao* estatisticas = NULL) {
+    auto inicio = chrono::steady_clock::now();
+    int numVertices = idsRotulos.size();
+    if (numThreads < 1) numThreads = 1;
+
+    construirReverso();
+
+    vector<int> graus(numVertices, 0);
+    int maiorGrau = 0;
+    for (int v = 0; v < numVertices; v++) {
+      if (verticesRemovidos[v]) continue;
+
+      graus[v] = offsetsReversos[v + 1] - offsetsReversos[v];
+      for (const pair<int, int>& aresta : arestas[v]) {
+        if (arestaValida(aresta)) graus[v]++;
+      }
+      maiorGrau = max(maiorGrau, graus[v]);
+    }
+
+    vector<int> pendentes = ordenarParaColoracao(ordem, graus);
+    vector<int> posicoes(numVertices, 0);
+    for (int i = 0; i < pendentes.size(); i++) posicoes[pendentes[i]] = i;
+
+    vector<atomic<int>> coresAtuais(numVertices);
+    for (int v = 0; v < numVertices; v++) coresAtuais[v].store(-1, memory_order_relaxed);
+
+    auto paraCadaVizinho = [&](int v, auto funcao) {
+      for (const pair<int, int>& aresta : arestas[v]) {
+        if (arestaValida(aresta) && aresta.first != v) funcao(aresta.first);
+      }
+      for (int k = offsetsReversos[v]; k < offsetsReversos[v + 1]; k++) {
+        if (origensReversas[k] != v) funcao(origensReversas[k]);
+      }
+    };
+
+    // marcas de cores proibidas de cada thread: proibidas[t][c] == carimbos[t]
+    // quando algum vizinho do vertice sendo colorido tem a cor c. O carimbo
+    // muda a cada vertice, entao um vertice recolorido em outra rodada nao
+    // ve as marcas que deixou na anterior
+    vector<vector<int>> proibidas(numThreads, vector<int>(maiorGrau + 1, 0));
+    vector<int> carimbos(numThreads, 0);
+    vector<vector<int>> conflitos(numThreads);
+    int rodadas = 0;
+    long long recoloridos = 0;
+
+    while (!pendentes.empty()) {
+      rodadas++;
+      atomic<int> proximo(0);
+
+      executarEmParalelo(numThreads, [&](int t) {
+        vector<int>& marcas = proibidas[t];
+        int& carimbo = carimbos[t];
+        int bloco;
+        while ((bloco = proximo.fetch_add(BLOCO_COLORACAO)) < pendentes.size()) {
+          int fim = min(bloco + BLOCO_COLORACAO, (int)pendentes.size());
+          for (int i = bloco; i < fim; i++) {
+            int v = pendentes[i];
+            carimbo++;
+            paraCadaVizinho(v, [&](int u) {
+              int c = coresAtuais[u].load(memory_order_relaxed);
+              if (c != -1) marcas[c] = carimbo;
+            });
+
+            int c = 0;
+            while (marcas[c] == carimbo) c++;
+            coresAtuais[v].store(c, memory_order_relaxed);
+          }
+        }
+      });
+
+      // com uma thread cada vertice ja viu as cores finais dos vizinhos
+      if (numThreads == 1) break;
+
+      proximo.store(0);
+      executarEmParalelo(numThreads, [&](int t) {
+        conflitos[t].clear();
+        int bloco;
+        while ((bloco = proximo.fetch_add(BLOCO_COLORACAO)) < pendentes.size()) {
+          int fim = min(bloco + BLOCO_COLORACAO, (int)pendentes.size());
+          for (int i = bloco; i < fim; i++) {
+            int v = pendentes[i];
+            int c = coresAtuais[v].load(memory_order_relaxed);
+            bool conflito = false;
+            paraCadaVizinho(v, [&](int u) {
+              if (!conflito && posicoes[u] < posicoes[v] && coresAtuais[u].load(memory_order_relaxed) == c) {
+                conflito = true;
+              }
+            });
+            if (conflito) conflitos[t].push_back(v);
+          }
+        }
+      });
+
+      pendentes.clear();
+      for (int t = 0; t < numThreads; t++) pendentes.insert(pendentes.end(), conflitos[t].begin(), conflitos[t].end());
+      recoloridos += pendentes.size();
+    }
+
+    int numCores = 0;
+    for (int v = 0; v < numVertices; v++) {
+      cores[v] = coresAtuais[v].load(memory_order_relaxed);
+      numCores = max(numCores, cores[v] + 1);
+    }
+
+    if (estatisticas != NULL) {
+      estatisticas->numCores = numCores;
+      estatisticas->rodadas = rodadas;
+      estatisticas->conflitos = recoloridos;
+      estatisticas->msExecucao = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+    }
+
+    return numCores;
+  }
+
+  /**
+   * Tambem monta em condensacao o DAG dos componentes.
+   **/
+  int componentesFortes(int* componentId, CondensacaoGrafo& condensacao) {
+    int numVertices = idsRotulos.size();
+    int numComponentes = componentesFortes(componentId);
+
+    // vertices agrupados por componente
+    vector<int> inicioComponente(numComponentes + 1, 0), verticesComponente(numVertices - qtdeVerticesRemovidos);
+    for (int v = 0; v < numVertices; v++) {
+      if (componentId[v] != -1) inicioComponente[componentId[v] + 1]++;
+    }
+    for (int c = 0; c < numComponentes; c++) inicioComponente[c + 1] += inicioComponente[c];
+
+    vector<int> cursores(inicioComponente.begin(), inicioComponente.end() - 1);
+    for (int v = 0; v < numVertices; v++) {
+      if (componentId[v] != -1) verticesComponente[cursores[componentId[v]]++] = v;
+    }
+
+    // ultimaOrigem[d] == c quando a aresta c -> d ja foi incluida
+    vector<int> ultimaOrigem(numComponentes, -1);
+    condensacao.numComponentes = numComponentes;
+    condensacao.offsets.assign(numComponentes + 1, 0);
+    condensacao.destinos.clear();
+
+    for (int c = 0; c < numComponentes; c++) {
+      for (int k = inicioComponente[c]; k < inicioComponente[c + 1]; k++) {
+        for (const pair<int, int>& aresta : arestas[verticesComponente[k]]) {
+          if (!arestaValida(aresta)) continue;
+
+          int d = componentId[aresta.first];
+          if (d != c && ultimaOrigem[d] != c) {
+            ultimaOrigem[d] = c;
+            condensacao.destinos.push_back(d);
+          }
+        }
+      }
+      condensacao.offsets[c + 1] = condensacao.destinos.size();
+    }
+
+    return numComponentes;
+  }
+
+  /**
+   * Usa a abordagem de navegacao BFS para listar as distancias
+   * entre o vertice rotuloVOrigem e cada um dos demais vertices.
+   * A funcao BFS consegue listar a menor distancia entre um vertice
+   * e os demais se o grafo for NAO-PONDERADO.
+   * Retorna um vetor de inteiros com a quantidade de arestas
+   * (distancia) e o vertice rotuloVOrigem e cada um dos demais vertices.
+   * Nao eh uma funcao recursiva.
+   * EH necessario utilizar a ED fila.
+   **/
+  int* bfs(string rotuloVOrigem) {
+    return bfs(rotuloVOrigem, (int*)NULL);
+  }
+
+  /**
+   * Se predecessores nao for NULL, tambem escreve nele o predecessor de
+   * cada vertice na arvore da busca: a origem eh seu proprio predecessor
+   * e vertices nao alcancados recebem -1 (veja reconstruirCaminho).
+   **/
+  int* bfs(string rotuloVOrigem, int* predecessores) {
+    if (bfs(rotuloVOrigem, espacoBusca) == -1) return NULL;
+
+    int* distancias = (int*)malloc(sizeof(int) * idsRotulos.size());
+
+    for (int i = 0; i < idsRotulos.size(); i++) distancias[i] = 0;
+    for (int v : espacoBusca.fila) distancias[v] = espacoBusca.distancias[v];
+
+    copiarPredecessores(predecessores);
+
+    return distancias;
+  }
+
+  /**
+   * bfs sem alocacao: os vertices alcancados ficam em espaco.fila, em
+   * ordem de visita, e a distancia e o predecessor de cada um em
+   * espaco.distancias e espaco.predecessores (veja espaco.caminhoAte).
+   * O custo eh proporcional ao que a busca alcanca, nao ao grafo.
+   * Retorna a quantidade de vertices alcancados, ou -1 se o vertice de
+   * origem nao existir.
+   **/
+  int bfs(string rotuloVOrigem, EspacoBusca& espaco) {
+    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
+    if (indiceRotuloOrigem == -1) return -1;
+
+    return bfsIndice(indiceRotuloOrigem, espaco);
+  }
+
+
+  /**
+   * Vertices a ate k arestas de rotuloVOrigem (incluindo ela), sem
+   * percorrer o grafo inteiro: a busca para na distancia k e usa as
+   * marcas de geracao do espaco, entao o custo eh proporcional ao tamanho
+   * da vizinhanca. Os vertices ficam em espaco.fila, em ordem de
+   * distancia, com as distancias em espaco.distancias.
+   * Retorna a quantidade de vertices, ou -1 se o vertice de origem nao
+   * existir ou k for negativo.
+   **/
+  int vizinhancaKHops(string rotuloVOrigem, int k, EspacoBusca& espaco) {
+    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
+    if (indiceRotuloOrigem == -1 || k < 0) return -1;
+
+    return bfsIndice(indiceRotuloOrigem, espaco, k);
+  }
+
+  /**
+   * Retorna os indices dos vertices a ate k arestas de rotuloVOrigem,
+   * em ordem de distancia (vazio se a origem nao existir).
+   **/
+  vector<int> vizinhancaKHops(string rotuloVOrigem, int k) {
+    if (vizinhancaKHops(rotuloVOrigem, k, espacoBusca) == -1) return vector<int>();
+    return espacoBusca.fila;
+  }
+
+  /**
+   * vizinhancaKHops para cada rotulo de origens, em lote, com o resultado
+   * em formato CSR (veja Vizinhancas). As origens sao divididas entre
+   * numThreads threads, cada uma com seu espaco; os espacos ficam no grafo
+   * e sao reaproveitados nos lotes seguintes.
+   * Retorna o total de vertices escritos, ou -1 (sem escrever nada) se
+   * algum rotulo nao existir ou k for negativo.
+   **/
+  int vizinhancasKHops(const vector<string>& origens, int k, Vizinhancas& resultado, int numThreads = 1) {
+    int qtdeOrigens = origens.size();
+    vector<int> indices(qtdeOrigens);
+
+    for (int i = 0; i < qtdeOrigens; i++) {
+      indices[i] = obterIndiceVertice(origens[i]);
+      if (indices[i] == -1) return -1;
+    }
+    if (k < 0) return -1;
+
+    numThreads = max(1, min(numThreads, qtdeOrigens));
+    if (espacosKHops.size() < numThreads) {
+      espacosKHops.resize(numThreads);
+      verticesKHops.resize(numThreads);
+      distanciasKHops.resize(numThreads);
+    }
+
+    // tamanho de cada vizinhanca, em offsets[i + 1]
+    resultado.offsets.assign(qtdeOrigens + 1, 0);
+
+    // a thread t faz as origens t, t + numThreads, ...
+    executarEmParalelo(numThreads, [&](int t) {
+      EspacoBusca& espaco = espacosKHops[t];
+      verticesKHops[t].clear();
+      distanciasKHops[t].clear();
+
+      for (int i = t; i < qtdeOrigens; i += numThreads) {
+        resultado.offsets[i + 1] = bfsIndice(indices[i], espaco, k);
+        for (int v : espaco.fila) {
+          verticesKHops[t].push_back(v);
+          distanciasKHops[t].push_back(espaco.distancias[v]);
+        }
+      }
+    });
+
+    for (int i = 0; i < qtdeOrigens; i++) resultado.offsets[i + 1] += resultado.offsets[i];
+
+    int total = resultado.offsets[qtdeOrigens];
+    resultado.vertices.resize(total);
+    resultado.distancias.resize(total);
+
+    for (int t = 0; t < numThreads; t++) {
+      int lidos = 0;
+      for (int i = t; i < qtdeOrigens; i += numThreads) {
+        int tamanho = resultado.offsets[i + 1] - resultado.offsets[i];
+        copy(verticesKHops[t].begin() + lidos, verticesKHops[t].begin() + lidos + tamanho,
+             resultado.vertices.begin() + resultado.offsets[i]);
+        copy(distanciasKHops[t].begin() + lidos, distanciasKHops[t].begin() + lidos + tamanho,
+             resultado.distancias.begin() + resultado.offsets[i]);
+        lidos += tamanho;
+      }
+    }
+
+    return total;
+  }
+
+  /**
+   * BFS com otimizacao de direcao: retorna as mesmas distancias de bfs,
+   * mas, nos niveis em que a fronteira eh grande (tipico de grafos sociais,
+   * de diametro pequeno), troca a expansao top-down por uma varredura
+   * bottom-up: cada vertice ainda nao visitado procura, entre as arestas
+   * que chegam nele, alguma vinda da fronteira, e para no primeiro achado.
+   * Nesses niveis a fronteira eh um mapa de bits.
+   * Retorna NULL se o vertice de origem nao existir.
+   **/
+  int* bfsDirecaoOtimizada(string rotuloVOrigem) {
+    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
+    if (indiceRotuloOrigem == -1) return NULL;
+
+    construirReverso();
+
+    int numVertices = idsRotulos.size();
+    int* distancias = (int*)malloc(sizeof(int) * numVertices);
+    for (int i = 0; i < numVertices; i++) distancias[i] = -1;
+    distancias[indiceRotuloOrigem] = 0;
+
+    vector<int> fronteira(1, indiceRotuloOrigem), proxima;
+    vector<uint64_t> bitsFronteira((numVertices + 63) / 64), bitsProxima((numVertices + 63) / 64);
+
+    bool bottomUp = false;
+    int tamanhoFronteira = 1, tamanhoAnterior = 0;
+    int64_t arestasFronteira = getGrau(indiceRotuloOrigem);
+    int64_t arestasNaoExploradas = origensReversas.size() - grauEntrada(indiceRotuloOrigem);
+
+    for (int nivel = 0; tamanhoFronteira > 0; nivel++) {
+      // so entra no modo bottom-up enquanto a fronteira cresce: no fim da
+      // busca restam poucas arestas, mas varrer todos os vertices seria caro
+      if (!bottomUp && tamanhoFronteira > tamanhoAnterior && arestasFronteira > arestasNaoExploradas / ALFA_BFS) {
+        fill(bitsFronteira.begin(), bitsFronteira.end(), 0);
+        for (int v : fronteira) bitsFronteira[v >> 6] |= 1ULL << (v & 63);
+        bottomUp = true;
+      } else if (bottomUp && tamanhoFronteira < tamanhoAnterior && tamanhoFronteira < numVertices / BETA_BFS) {
+        fronteira.clear();
+        for (int v = 0; v < numVertices; v++) {
+          if (bitsFronteira[v >> 6] >> (v & 63) & 1) fronteira.push_back(v);
+        }
+        bottomUp = false;
+      }
+
+      tamanhoAnterior = tamanhoFronteira;
+      tamanhoFronteira = 0;
+      arestasFronteira = 0;
+
+      if (bottomUp) {
+        fill(bitsProxima.begin(), bitsProxima.end(), 0);
+
+        for (int v = 0; v < numVertices; v++) {
+          if (distancias[v] != -1 || verticesRemovidos[v]) continue;
+
+          for (int i = offsetsReversos[v]; i < offsetsReversos[v + 1]; i++) {
+            int u = origensReversas[i];
+            if (bitsFronteira[u >> 6] >> (u & 63) & 1) {
+              distancias[v] = nivel + 1;
+              bitsProxima[v >> 6] |= 1ULL << (v & 63);
+              tamanhoFronteira++;
+              arestasFronteira += getGrau(v);
+              arestasNaoExploradas -= grauEntrada(v);
+              break;
+            }
+          }
+        }
+        bitsFronteira.swap(bitsProxima);
+      } else {
+        proxima.clear();
+
+        for (int u : fronteira) {
+          for (const pair<int, int>& aresta : getVizinhos(u)) {
+            if (arestaValida(aresta) && distancias[aresta.first] == -1) {
+              distancias[aresta.first] = nivel + 1;
+              proxima.push_back(aresta.first);
+              arestasFronteira += getGrau(aresta.first);
+              arestasNaoExploradas -= grauEntrada(aresta.first);
+            }
+          }
+        }
+        fronteira.swap(proxima);
+        tamanhoFronteira = fronteira.size();
+      }
+    }
+
+    // como em bfs, vertices inalcancaveis ficam com distancia 0
+    for (int i = 0; i < numVertices; i++) {
+      if (distancias[i] == -1) distancias[i] = 0;
+    }
+
+    return distancias;
+  }
+
+  /**
+   * Executa uma bfs a partir de cada rotulo de origens e escreve as
+   * distancias na matriz distancias, fornecida por quem chama, com
+   * origens.size() linhas de getNumVertices() colunas: a distancia da
+   * origem i ate o vertice v fica em distancias[i * getNumVertices() + v].
+   * Como em bfs, vertices inalcancaveis ficam com distancia 0.
+   * As buscas sao feitas em lotes de BUSCAS_POR_LOTE (MS-BFS): cada vertice
+   * guarda um bit por busca do lote, e uma unica varredura dos vizinhos de
+   * um vertice avanca todas as buscas que o alcancaram no mesmo nivel.
+   * Retorna -1 (sem escrever nada) se algum rotulo nao existir e 0 caso contrario.
+   **/
+  int bfsMultiplasOrigens(const vector<string>& origens, int* distancias) {
+    int numVertices = idsRotulos.size();
+    vector<int> indicesOrigens;
+
+    for (const string& origem : origens) {
+      int indice = obterIndiceVertice(origem);
+      if (indice == -1) return -1;
+      indicesOrigens.push_back(indice);
+    }
+
+    for (int64_t i = 0; i < (int64_t)origens.size() * numVertices; i++) distancias[i] = 0;
+
+    // origens proximas no mesmo lote compartilham mais varreduras; sem outra
+    // informacao, usamos a proximidade dos indices
+    vector<int> ordem(indicesOrigens.size());
+    for (int i = 0; i < ordem.size(); i++) ordem[i] = i;
+    stable_sort(ordem.begin(), ordem.end(), [&](int a, int b) { return indicesOrigens[a] < indicesOrigens[b]; });
+
+    // bit b: o vertice ja foi alcancado / esta na fronteira atual / na proxima, na busca b do lote
+    vector<uint64_t> vistos(numVertices), fronteira(numVertices), proxima(numVertices);
+
+    // vertices com algum bit na fronteira atual (em ordem crescente) / na proxima
+    vector<int> ativos, tocados;
+
+    for (int lote = 0; lote < ordem.size(); lote += BUSCAS_POR_LOTE) {
+      int qtdeBuscas = min(BUSCAS_POR_LOTE, (int)ordem.size() - lote);
+
+      fill(vistos.begin(), vistos.end(), 0);
+      ativos.clear();
+
+      for (int b = 0; b < qtdeBuscas; b++) {
+        int origem = indicesOrigens[ordem[lote + b]];
+        if (fronteira[origem] == 0) ativos.push_back(origem);
+        vistos[origem] |= 1ULL << b;
+        fronteira[origem] |= 1ULL << b;
+      }
+
+      for (int nivel = 1; !ativos.empty(); nivel++) {
+        tocados.clear();
+
+        for (int v : ativos) {
+          for (const pair<int, int>& aresta : getVizinhos(v)) {
+            if (!arestaValida(aresta)) continue;
+
+            uint64_t novas = fronteira[v] & ~vistos[aresta.first];
+            if (novas == 0) continue;
+
+            if (proxima[aresta.first] == 0) tocados.push_back(aresta.first);
+            proxima[aresta.first] |= novas;
+          }
+        }
+
+        for (int v : ativos) fronteira[v] = 0;
+
+        // a proxima fronteira fica em ordem crescente; quando ela eh grande,
+        // varrer todos os vertices sai mais barato que ordenar a lista
+        if (tocados.size() > numVertices / 16) {
+          tocados.clear();
+          for (int v = 0; v < numVertices; v++) {
+            if (proxima[v] != 0) tocados.push_back(v);
+          }
+        } else {
+          sort(tocados.begin(), tocados.end());
+        }
+        ativos.swap(tocados);
+
+        for (int v : ativos) {
+          uint64_t novas = proxima[v];
+          proxima[v] = 0;
+          fronteira[v] = novas;
+          vistos[v] |= novas;
+
+          for (; novas != 0; novas &= novas - 1) distancias[(int64_t)ordem[lote + menorBit(novas)] * numVertices + v] = nivel;
+        }
+      }
+    }
+
+    return 0;
+  }
+
+  /**
+   * BFS sincronizada por niveis com numThreads threads. Em cada nivel, as
+   * threads pegam blocos da fronteira, e cada vertice descoberto eh
+   * reivindicado com compare-and-swap na sua distancia, de modo que apenas
+   * uma thread o coloca na proxima fronteira. Cada thread guarda os vertices
+   * que descobriu em um buffer proprio; na barreira do fim do nivel, os
+   * buffers sao concatenados na proxima fronteira.
+   * Retorna as mesmas distancias de bfs, ou NULL se a origem nao existir.
+   **/
+  int* bfsParalela(string rotuloVOrigem, int numThreads) {
+    int indiceRotuloOrigem = obterIndiceVertice(rotuloVOrigem);
+    if (indiceRotuloOrigem == -1) return NULL;
+    if (numThreads < 1) numThreads = 1;
+
+    int numVertices = idsRotulos.size();
+    vector<atomic<int>> niveis(numVertices);
+    for (int i = 0; i < numVertices; i++) niveis[i].store(-1, memory_order_relaxed);
+    niveis[indiceRotuloOrigem].store(0, memory_order_relaxed);
+
+    // fronteiras[nivel % 2] eh a fronteira atual e a outra, a proxima
+    vector<int> fronteiras[2];
+    fronteiras[0].push_back(indiceRotuloOrigem);
+
+    vector<vector<int>> descobertos(numThreads);
+    vector<int> inicios(numThreads + 1);
+    atomic<int> cursor(0);
+    BarreiraThreads barreira(numThreads);
+
+    executarEmParalelo(numThreads, [&](int t) {
+      for (int nivel = 0; !fronteiras[nivel % 2].empty(); nivel++) {
+        const vector<int>& fronteira = fronteiras[nivel % 2];
+        vector<int>& proxima = fronteiras[(nivel + 1) % 2];
+        vector<int>& locais = descobertos[t];
+        locais.clear();
+
+        for (int ini = cursor.fetch_add(BLOCO_BFS_PARALELA); ini < fronteira.size(); ini = cursor.fetch_add(BLOCO_BFS_PARALELA)) {
+          int fim = min(ini + BLOCO_BFS_PARALELA, (int)fronteira.size());
+
+          for (int i = ini; i < fim; i++) {
+            for (const pair<int, int>& aresta : getVizinhos(fronteira[i])) {
+              if (!arestaValida(aresta) || niveis[aresta.first].load(memory_order_relaxed) != -1) continue;
+
+              int esperado = -1;
+              if (niveis[aresta.first].compare_exchange_strong(esperado, nivel + 1)) locais.push_back(aresta.first);
+            }
+          }
+        }
+        barreira.aguardar();
+
+        if (t == 0) {
+          inicios[0] = 0;
+          for (int k = 0; k < numThreads; k++) inicios[k + 1] = inicios[k] + descobertos[k].size();
+          proxima.resize(inicios[numThreads]);
+          cursor.store(0);
+        }
+        barreira.aguardar();
+
+        copy(locais.begin(), locais.end(), proxima.begin() + inicios[t]);
+        barreira.aguardar();
+      }
+    });
+
+    int* distancias = (int*)malloc(sizeof(int) * numVertices);
+    for (int i = 0; i < numVertices; i++) {
+      int nivel = niveis[i].load(memory_order_relaxed);
+      distancias[i] = nivel == -1 ? 0 : nivel;
+    }
+
+    return distancias;
+  }
+
+  /**
+   * Visao somente-leitura de uma lista de vizinhos.
+   * Aponta diretamente para o vetor interno, entao nao ha copia nem alocacao,
+   * mas deixa de ser valida se o grafo for modificado.
+   **/
+  class Vizinhos {
+   private:
+    const pair<int, int>* inicio;
+    const pair<int, int>* fim;
+
+   public:
+    Vizinhos(const pair<int, int>* inicio, const pair<int, int>* fim) : inicio(inicio), fim(fim) {}
+
+    const pair<int, int>* begin() const {
+      return inicio;
+    }
+
+    const pair<int, int>* end() const {
+      return fim;
+    }
+
+    int size() const {
+      return fim - inicio;
+    }
+
+    bool empty() const {
+      return inicio == fim;
+    }
+
+    const pair<int, int>& operator[](int i) const {
+      return inicio[i];
+    }
+  };
+
+  /**
+   * Visao somente-leitura dos rotulos dos vertices, na ordem dos indices.
+   * Le direto do pool, sem copiar nenhum rotulo, mas deixa de ser valida
+   * se o grafo for modificado.
+   **/
+  class Rotulos {
+   private:
+    const PoolRotulos* pool;
+    const int* ids;
+    int qtde;
+
+   public:
+    class Iterador {
+     private:
+      const PoolRotulos* pool;
+      const int* id;
+
+     public:
+      typedef input_iterator_tag iterator_category;
+      typedef string_view value_type;
+      typedef ptrdiff_t difference_type;
+      typedef const string_view* pointer;
+      typedef string_view reference;
+
+      Iterador(const PoolRotulos* pool, const int* id) : pool(pool), id(id) {}
+
+      string_view operator*() const {
+        return pool->obter(*id);
+      }
+
+      Iterador& operator++() {
+        id++;
+        return *this;
+      }
+
+      bool operator==(const Iterador& outro) const {
+        return id == outro.id;
+      }
+
+      bool operator!=(const Iterador& outro) const {
+        return id != outro.id;
+      }
+    };
+
+    Rotulos(const PoolRotulos* pool, const int* ids, int qtde) : pool(pool), ids(ids), qtde(qtde) {}
+
+    Iterador begin() const {
+      return Iterador(pool, ids);
+    }
+
+    Iterador end() const {
+      return Iterador(pool, ids + qtde);
+    }
+
+    int size() const {
+      return qtde;
+    }
+
+    bool empty() const {
+      return qtde == 0;
+    }
+
+    string_view operator[](int i) const {
+      return pool->obter(ids[i]);
+    }
+  };
+
+  /**
+   * Percurso preguicoso: entrega os vertices um a um, na ordem da BFS, da
+   * DFS (pre-ordem) ou do Dijkstra, e so avanca a busca quando o proximo
+   * vertice eh pedido. Os vizinhos de um vertice so sao examinados depois
+   * que ele eh entregue e o seguinte eh pedido, entao parar no meio (break
+   * em um for, ou deixar de chamar avancar) custa apenas o que foi lido.
+   *   for (VerticeAlcancado alcancado : grafo->percorrer("v1", PERCURSO_BFS)) ...
+   * A origem eh sempre o primeiro vertice; se ela nao existir, o percurso
+   * eh vazio. Os predecessores ficam no espaco (veja caminhoAte).
+   * O percurso usa o espaco recebido ou, sem ele, um proprio; o grafo e o
+   * espaco nao devem ser modificados nem reutilizados enquanto ele estiver
+   * em uso.
+   **/
+  class Percurso {
+   private:
+    GrafoListaAdj* grafo;
+    TipoPercurso tipo;
+    EspacoBusca proprio;
+    EspacoBusca* espaco;
+    VerticeAlcancado atual;
+    bool terminou;
+
+    // proximo vertice da fila a ser entregue na BFS
+    int frente;
+
+    void expandir(int v) {
+      for (const pair<int, int>& aresta : grafo->getVizinhos(v)) {
+        if (!grafo->arestaValida(aresta)) continue;
+
+        int u = aresta.first;
+        if (tipo == PERCURSO_BFS) {
+          if (espaco->visitado(u)) continue;
+
+          espaco->visitar(u);
+          espaco->distancias[u] = espaco->distancias[v] + 1;
+          espaco->predecessores[u] = v;
+          espaco->fila.push_back(u);
+        } else {
+          int novaDistancia = espaco->distancias[v] + aresta.second;
+          if (espaco->visitado(u) && novaDistancia >= espaco->distancias[u]) continue;
+
+          espaco->visitar(u);
+          espaco->distancias[u] = novaDistancia;
+          espaco->predecessores[u] = v;
+          espaco->heap.push_back(pair<int, int>(novaDistancia, u));
+          push_heap(espaco->heap.begin(), espaco->heap.end(), greater<pair<int, int>>());
+        }
+      }
+    }
+
+    bool avancarDFS() {
+      vector<pair<int, int>>& pilha = espaco->pilha;
+
+      while (!pilha.empty()) {
+        int v = pilha.back().first;
+        Vizinhos vizinhos = grafo->getVizinhos(v);
+
+        if (pilha.back().second == vizinhos.size()) {
+          pilha.pop_back();
+          continue;
+        }
+
+        const pair<int, int>& aresta = vizinhos[pilha.back().second++];
+        if (!grafo->arestaValida(aresta) || espaco->visitado(aresta.first)) continue;
+
+        int u = aresta.first;
+        espaco->visitar(u);
+        espaco->distancias[u] = pilha.size();
+        espaco->predecessores[u] = v;
+        pilha.push_back(pair<int, int>(u, 0));
+
+        atual.vertice = u;
+        atual.distancia = espaco->distancias[u];
+        return true;
+      }
+
+      return false;
+    }
+
+   public:
+    Percurso(GrafoListaAdj* grafo, int origem, TipoPercurso tipo, EspacoBusca* espacoExterno)
+        : grafo(grafo), tipo(tipo), espaco(espacoExterno != NULL ? espacoExterno : &proprio), frente(1) {
+      terminou = origem == -1;
+      if (terminou) return;
+
+      espaco->preparar(grafo->idsRotulos.size());
+      espaco->visitar(origem);
+      espaco->distancias[origem] = 0;
+      espaco->predecessores[origem] = origem;
+
+      if (tipo == PERCURSO_BFS) espaco->fila.push_back(origem);
+      if (tipo == PERCURSO_DFS) espaco->pilha.push_back(pair<int, int>(origem, 0));
+
+      atual.vertice = origem;
+      atual.distancia = 0;
+    }
+
+    // o espaco proprio nao pode mudar de endereco
+    Percurso(const Percurso&) = delete;
+    Percurso& operator=(const Percurso&) = delete;
+
+    /**
+     * Passa para o proximo vertice. Retorna false quando nao ha mais
+     * vertices alcancaveis.
+     **/
+    bool avancar() {
+      if (terminou) return false;
+
+      if (tipo == PERCURSO_DFS) {
+        terminou = !avancarDFS();
+        return !terminou;
+      }
+
+      expandir(atual.vertice);
+
+      if (tipo == PERCURSO_BFS) {
+        terminou = frente == espaco->fila.size();
+        if (terminou) return false;
+
+        atual.vertice = espaco->fila[frente++];
+        atual.distancia = espaco->distancias[atual.vertice];
+        return true;
+      }
+
+      vector<pair<int, int>>& heap = espaco->heap;
+      while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
+        pair<int, int> topo = heap.back();
+        heap.pop_back();
+
+        // entradas antigas, de antes de uma distancia menor ser achada
+        if (topo.first > espaco->distancias[topo.second]) continue;
+
+        atual.vertice = topo.second;
+        atual.distancia = topo.first;
+        return true;
+      }
+
+      terminou = true;
+      return false;
+    }
+
+    bool fim() const {
+      return terminou;
+    }
+
+    const VerticeAlcancado& getAtual() const {
+      return atual;
+    }
+
+    const EspacoBusca& getEspaco() const {
+      return *espaco;
+    }
+
+    class Iterador {
+     private:
+      // NULL no fim do percurso
+      Percurso* percurso;
+
+     public:
+      typedef input_iterator_tag iterator_category;
+      typedef VerticeAlcancado value_type;
+      typedef ptrdiff_t difference_type;
+      typedef const VerticeAlcancado* pointer;
+      typedef const VerticeAlcancado& reference;
+
+      Iterador(Percurso* percurso) : percurso(percurso) {}
+
+      reference operator*() const {
+        return percurso->atual;
+      }
+
+      pointer operator->() const {
+        return &percurso->atual;
+      }
+
+      Iterador& operator++() {
+        if (!percurso->avancar()) percurso = NULL;
+        return *this;
+      }
+
+      bool operator==(const Iterador& outro) const {
+        return percurso == outro.percurso;
+      }
+
+      bool operator!=(const Iterador& outro) const {
+        return percurso != outro.percurso;
+      }
+    };
+
+    Iterador begin() {
+      return Iterador(terminou ? NULL : this);
+    }
+
+    Iterador end() {
+      return Iterador(NULL);
+    }
+  };
+
+  /**
+   * Percurso preguicoso a partir de rotuloVOrigem. Com espaco, o percurso
+   * nao aloca memoria depois que os vetores do espaco atingem o tamanho
+   * do grafo. A ordem de Dijkstra supoe pesos nao negativos.
+   **/
+  Percurso percorrer(string rotuloVOrigem, TipoPercurso tipo) {
+    return Percurso(this, obterIndiceVertice(rotuloVOrigem), tipo, NULL);
+  }
+
+  Percurso percorrer(string rotuloVOrigem, TipoPercurso tipo, EspacoBusca& espaco) {
+    return Percurso(this, obterIndiceVertice(rotuloVOrigem), tipo, &espaco);
+  }
+
+  /**
+   * DFS iterativa a partir do vertice de indice indiceVOrigem, com pilha
+   * explicita: caminhos longos nao estouram a pilha de chamadas e cada
+   * aresta eh examinada uma unica vez.
+   * preOrdem(v) eh chamada quando v eh descoberto; se retornar false, a
+   * busca eh interrompida e dfs retorna false. posOrdem(v) eh chamada
+   * quando todos os vizinhos de v foram explorados.
+   * Os vertices ja visitados no espaco nao sao visitados de novo, o que
+   * permite chamar dfs varias vezes com o mesmo espaco (colorir); chame
+   * espaco.preparar() antes de uma busca nova.
+   **/
+  template <typename FuncaoPre, typename FuncaoPos>
+  bool dfs(int indiceVOrigem, EspacoBusca& espaco, FuncaoPre preOrdem, FuncaoPos posOrdem) {
+    if (espaco.visitado(indiceVOrigem)) return true;
+
+    espaco.visitar(indiceVOrigem);
+    if (!preOrdem(indiceVOrigem)) return false;
+    espaco.pilha.push_back(pair<int, int>(indiceVOrigem, 0));
+
+    while (!espaco.pilha.empty()) {
+      int v = espaco.pilha.back().first;
+      Vizinhos vizinhos = getVizinhos(v);
+
+      if (espaco.pilha.back().second == vizinhos.size()) {
+        espaco.pilha.pop_back();
+        posOrdem(v);
+        continue;
+      }
+
+      const pair<int, int>& aresta = vizinhos[espaco.pilha.back().second++];
+      if (!arestaValida(aresta) || espaco.visitado(aresta.first)) continue;
+
+      espaco.visitar(aresta.first);
+      if (!preOrdem(aresta.first)) {
+        espaco.pilha.clear();
+        return false;
+      }
+      espaco.pilha.push_back(pair<int, int>(aresta.first, 0));
+    }
+
+    return true;
+  }
+
+  template <typename FuncaoPre>
+  bool dfs(int indiceVOrigem, EspacoBusca& espaco, FuncaoPre preOrdem) {
+    return dfs(indiceVOrigem, espaco, preOrdem, [](int) {});
+  }
+
+  /**
+   * Escreve em caminho os vertices do caminho da origem ate destino,
+   * seguindo um vetor de predecessores preenchido por bfs. caminho deve
+   * ter espaco para o numero de vertices do grafo.
+   * Retorna a quantidade de vertices do caminho, ou -1 se destino nao
+   * foi alcancado.
+   **/
+  static int reconstruirCaminho(const int* predecessores, int destino, int* caminho) {
+    if (predecessores[destino] == -1) return -1;
+
+    int tamanho = 1;
+    for (int v = destino; predecessores[v] != v; v = predecessores[v]) tamanho++;
+
+    int v = destino;
+    for (int i = tamanho - 1; i >= 0; i--) {
+      caminho[i] = v;
+      v = predecessores[v];
+    }
+    return tamanho;
+  }
+
+  Vizinhos getVizinhos(int indiceVertice) {
+    const vector<pair<int, int>>& lista = arestas[indiceVertice];
+    return Vizinhos(lista.data(), lista.data() + lista.size());
+  }
+
+  int getGrau(int indiceVertice) {
+    return arestas[indiceVertice].size();
+  }
+
+  /**
+   * A visao aponta para o pool e deixa de ser valida quando um novo
+   * rotulo eh inserido.
+   **/
+  string_view getRotulo(int indiceVertice) {
+    return rotulos.obter(idsRotulos[indiceVertice]);
+  }
+
+  /**
+   * Id do rotulo do vertice no pool. Diferente do indice do vertice,
+   * ele nao muda quando o grafo eh compactado.
+   **/
+  int getIdRotulo(int indiceVertice) {
+    return idsRotulos[indiceVertice];
+  }
+
+  const PoolRotulos& getPoolRotulos() {
+    return rotulos;
+  }
+
+  int getNumVertices() {
+    return idsRotulos.size();
+  }
+
+  Rotulos getVertices() {
+    return Rotulos(&rotulos, idsRotulos.data(), idsRotulos.size());
+  }
+
+  const vector<vector<pair<int, int>>>& getArestas() {
+    return arestas;
+  }
+};
+
+// definida aqui porque usa GrafoListaAdj::reconstruirCaminho
+inline int EspacoBusca::caminhoAte(int destino, int* caminho) const {
+  if (!visitado(destino)) return -1;
+  return GrafoListaAdj::reconstruirCaminho(predecessores.data(), destino, caminho);
+}
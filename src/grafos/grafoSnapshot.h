@@ -0,0 +1,424 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "grafoCSR.h"
+using namespace std;
+
+// quantidade maxima de leitores registrados ao mesmo tempo
+#define MAX_LEITORES 64
+
+/**
+ * Geracao publicada do grafo: um GrafoCSR imutavel e seu numero.
+ **/
+class GeracaoGrafo {
+ public:
+  GrafoCSR* grafo;
+  uint64_t numero;
+
+  // epoca em que a geracao deixou de ser a atual (0 enquanto publicada)
+  uint64_t epocaAposentadoria;
+
+  GeracaoGrafo(GrafoCSR* grafo, uint64_t numero) : grafo(grafo), numero(numero), epocaAposentadoria(0) {}
+
+  ~GeracaoGrafo() {
+    delete grafo;
+  }
+};
+
+/**
+ * Alteracao registrada no log de GrafoVersionado, aplicada apenas
+ * na proxima chamada de publicar().
+ **/
+class AlteracaoGrafo {
+ public:
+  enum Tipo { INSERIR_VERTICE, INSERIR_ARESTA, REMOVER_ARESTA };
+
+  Tipo tipo;
+  string origem;
+  string destino;
+  int peso;
+
+  AlteracaoGrafo(Tipo tipo, string origem, string destino, int peso)
+      : tipo(tipo), origem(origem), destino(destino), peso(peso) {}
+};
+
+class GrafoVersionado;
+
+/**
+ * Visao fixa de uma geracao do grafo. Enquanto o snapshot existir, a
+ * geracao nao eh liberada, mesmo que novas geracoes sejam publicadas.
+ * As consultas nao usam nenhuma trava e nunca esperam pelo escritor.
+ * O snapshot pertence a um unico leitor (uma thread) e nao pode ser copiado.
+ **/
+class SnapshotGrafo {
+ private:
+  GrafoVersionado* dono;
+  int leitor;
+  GeracaoGrafo* geracao;
+
+  friend class GrafoVersionado;
+
+  SnapshotGrafo(GrafoVersionado* dono, int leitor, GeracaoGrafo* geracao) : dono(dono), leitor(leitor), geracao(geracao) {}
+
+ public:
+  SnapshotGrafo(SnapshotGrafo&& outro) : dono(outro.dono), leitor(outro.leitor), geracao(outro.geracao) {
+    outro.dono = NULL;
+  }
+
+  SnapshotGrafo(const SnapshotGrafo&) = delete;
+  SnapshotGrafo& operator=(const SnapshotGrafo&) = delete;
+
+  inline ~SnapshotGrafo();
+
+  uint64_t getGeracao() {
+    return geracao->numero;
+  }
+
+  /**
+   * Apenas os metodos de leitura do GrafoCSR podem ser usados.
+   **/
+  GrafoCSR* getGrafo() {
+    return geracao->grafo;
+  }
+
+  int* bfs(string_view rotuloVOrigem) {
+    return geracao->grafo->bfs(rotuloVOrigem);
+  }
+
+  int* dijkstra(string_view rotuloVOrigem) {
+    return geracao->grafo->dijkstra(rotuloVOrigem);
+  }
+
+  bool saoConectados(string_view rotuloVOrigem, string_view rotuloVDestino) {
+    return geracao->grafo->saoConectados(rotuloVOrigem, rotuloVDestino);
+  }
+
+  /**
+   * Mesma semantica do haCaminho de GrafoListaAdj: um vertice so tem
+   * caminho para si mesmo se tiver um laco.
+   **/
+  bool haCaminho(string_view rotuloVOrigem, string_view rotuloVDestino) {
+    GrafoCSR* grafo = geracao->grafo;
+    int origem = grafo->obterIndiceVertice(rotuloVOrigem);
+    int destino = grafo->obterIndiceVertice(rotuloVDestino);
+
+    if (origem == -1 || destino == -1) return false;
+
+    const int64_t* offsets = grafo->getOffsets();
+    const int* destinos = grafo->getDestinos();
+    vector<bool> visitados(grafo->numVertices(), false);
+    vector<int> pilha(1, origem);
+
+    // as listas do CSR sao ordenadas
+    if (origem == destino) {
+      return binary_search(destinos + offsets[origem], destinos + offsets[origem + 1], origem);
+    }
+
+    visitados[origem] = true;
+
+    while (!pilha.empty()) {
+      int v = pilha.back();
+      pilha.pop_back();
+
+      for (int64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+        if (destinos[i] == destino) return true;
+        if (!visitados[destinos[i]]) {
+          visitados[destinos[i]] = true;
+          pilha.push_back(destinos[i]);
+        }
+      }
+    }
+
+    return false;
+  }
+};
+
+/**
+ * Grafo com versoes: leitores consultam snapshots imutaveis (geracoes
+ * GrafoCSR) sem travas, enquanto um escritor acumula alteracoes em um
+ * log e, em publicar(), monta a proxima geracao e a publica de forma
+ * atomica.
+ *
+ * As geracoes antigas sao liberadas por reclamacao baseada em epocas:
+ * cada leitor anota a epoca global ao fixar um snapshot, e uma geracao
+ * aposentada na epoca E so eh liberada quando nenhum leitor ativo tem
+ * epoca menor que E (ou seja, ninguem pode estar lendo a geracao).
+ *
+ * Uso:
+ *   int leitor = grafo.registrarLeitor();
+ *   {
+ *     SnapshotGrafo snapshot = grafo.fixar(leitor);
+ *     int* distancias = snapshot.dijkstra("v1");
+ *     ...
+ *   }
+ *   grafo.desregistrarLeitor(leitor);
+ **/
+class GrafoVersionado {
+ private:
+  // epoca anotada por um leitor; 0 quando ele nao tem snapshot fixado.
+  // Cada slot ocupa sua propria linha de cache
+  class alignas(64) SlotLeitor {
+   public:
+    atomic<uint64_t> epoca;
+    atomic<bool> ocupado;
+
+    SlotLeitor() : epoca(0), ocupado(false) {}
+  };
+
+  atomic<GeracaoGrafo*> atual;
+  atomic<uint64_t> epocaGlobal;
+  SlotLeitor leitores[MAX_LEITORES];
+
+  // protege o log de alteracoes
+  mutex mutexLog;
+  vector<AlteracaoGrafo> log;
+
+  // garante um unico publicar() por vez; tambem protege aposentadas
+  mutex mutexPublicacao;
+  vector<GeracaoGrafo*> aposentadas;
+
+  friend class SnapshotGrafo;
+
+  void liberarLeitor(int leitor) {
+    leitores[leitor].epoca.store(0);
+  }
+
+  void registrar(AlteracaoGrafo alteracao) {
+    lock_guard<mutex> trava(mutexLog);
+    log.push_back(alteracao);
+  }
+
+  static int64_t chave(int origem, int destino) {
+    return ((int64_t)origem << 32) | (uint32_t)destino;
+  }
+
+  /**
+   * Monta a proxima geracao a partir da geracao atual e do log.
+   * Cada aresta recebe a posicao do log em que foi inserida (0 para as da
+   * geracao atual), e uma remocao descarta as arestas inseridas antes dela.
+   **/
+  GrafoCSR* aplicar(GrafoCSR* anterior, const vector<AlteracaoGrafo>& alteracoes) {
+    vector<string> rotulos;
+    unordered_map<string, int> indicesNovos;
+
+    for (int v = 0; v < anterior->numVertices(); v++) rotulos.push_back(string(anterior->rotulo(v)));
+
+    auto obterIndice = [&](const string& rotulo) {
+      int indice = anterior->obterIndiceVertice(rotulo);
+      if (indice != -1) return indice;
+
+      auto it = indicesNovos.find(rotulo);
+      return it == indicesNovos.end() ? -1 : it->second;
+    };
+
+    vector<GrafoCSR::Aresta> arestas;
+    vector<int> posicoes;
+
+    const int64_t* offsets = anterior->getOffsets();
+    for (int v = 0; v < anterior->numVertices(); v++) {
+      for (int64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+        arestas.push_back(GrafoCSR::Aresta(v, anterior->getDestinos()[i], anterior->getPesos()[i]));
+        posicoes.push_back(0);
+      }
+    }
+
+    unordered_map<int64_t, int> remocoes;
+
+    for (int p = 0; p < alteracoes.size(); p++) {
+      const AlteracaoGrafo& alteracao = alteracoes[p];
+
+      if (alteracao.tipo == AlteracaoGrafo::INSERIR_VERTICE) {
+        if (obterIndice(alteracao.origem) == -1) {
+          indicesNovos[alteracao.origem] = rotulos.size();
+          rotulos.push_back(alteracao.origem);
+        }
+        continue;
+      }
+
+      int origem = obterIndice(alteracao.origem);
+      int destino = obterIndice(alteracao.destino);
+      if (origem == -1 || destino == -1) continue;
+
+      if (alteracao.tipo == AlteracaoGrafo::INSERIR_ARESTA) {
+        arestas.push_back(GrafoCSR::Aresta(origem, destino, alteracao.peso));
+        posicoes.push_back(p + 1);
+      } else {
+        remocoes[chave(origem, destino)] = p + 1;
+      }
+    }
+
+    if (!remocoes.empty()) {
+      int qtde = 0;
+      for (int i = 0; i < arestas.size(); i++) {
+        auto it = remocoes.find(chave(arestas[i].origem, arestas[i].destino));
+        if (it == remocoes.end() || posicoes[i] > it->second) arestas[qtde++] = arestas[i];
+      }
+      arestas.resize(qtde);
+    }
+
+    return GrafoCSR::construir(rotulos, arestas);
+  }
+
+  /**
+   * Libera as geracoes aposentadas que nenhum leitor pode estar usando.
+   * Deve ser chamada com mutexPublicacao travado.
+   **/
+  void reciclar() {
+    uint64_t menorEpoca = UINT64_MAX;
+    for (int l = 0; l < MAX_LEITORES; l++) {
+      uint64_t epoca = leitores[l].epoca.load();
+      if (epoca != 0 && epoca < menorEpoca) menorEpoca = epoca;
+    }
+
+    int qtde = 0;
+    for (GeracaoGrafo* geracao : aposentadas) {
+      if (geracao->epocaAposentadoria <= menorEpoca)
+        delete geracao;
+      else
+        aposentadas[qtde++] = geracao;
+    }
+    aposentadas.resize(qtde);
+  }
+
+ public:
+  GrafoVersionado() : epocaGlobal(1) {
+    atual.store(new GeracaoGrafo(GrafoCSR::construir(vector<string>(), vector<GrafoCSR::Aresta>()), 0));
+  }
+
+  /**
+   * A geracao inicial eh o grafo recebido, que passa a pertencer a este objeto.
+   **/
+  GrafoVersionado(GrafoCSR* inicial) : epocaGlobal(1) {
+    inicial->obterIndiceVertice("");
+    atual.store(new GeracaoGrafo(inicial, 0));
+  }
+
+  /**
+   * Nao pode haver snapshots fixados.
+   **/
+  ~GrafoVersionado() {
+    for (GeracaoGrafo* geracao : aposentadas) delete geracao;
+    delete atual.load();
+  }
+
+  GrafoVersionado(const GrafoVersionado&) = delete;
+  GrafoVersionado& operator=(const GrafoVersionado&) = delete;
+
+  /**
+   * Reserva um slot de leitor. Cada thread leitora usa o seu.
+   * Retorna -1 se ja houver MAX_LEITORES leitores registrados.
+   **/
+  int registrarLeitor() {
+    for (int l = 0; l < MAX_LEITORES; l++) {
+      bool livre = false;
+      if (leitores[l].ocupado.compare_exchange_strong(livre, true)) return l;
+    }
+    return -1;
+  }
+
+  void desregistrarLeitor(int leitor) {
+    leitores[leitor].epoca.store(0);
+    leitores[leitor].ocupado.store(false);
+  }
+
+  /**
+   * Fixa a geracao atual para o leitor. A epoca eh anotada antes de ler
+   * o ponteiro da geracao: assim, se a geracao lida ja tiver sido
+   * aposentada, foi em uma epoca maior que a anotada, e ela nao sera
+   * liberada enquanto o snapshot existir.
+   * Cada leitor pode ter apenas um snapshot fixado por vez.
+   **/
+  SnapshotGrafo fixar(int leitor) {
+    leitores[leitor].epoca.store(epocaGlobal.load());
+    return SnapshotGrafo(this, leitor, atual.load());
+  }
+
+  uint64_t getGeracaoAtual() {
+    return atual.load()->numero;
+  }
+
+  void inserirVertice(string rotuloVertice) {
+    registrar(AlteracaoGrafo(AlteracaoGrafo::INSERIR_VERTICE, rotuloVertice, "", 0));
+  }
+
+  void inserirArestaDirecionada(string rotuloVOrigem, string rotuloVDestino, int peso) {
+    registrar(AlteracaoGrafo(AlteracaoGrafo::INSERIR_ARESTA, rotuloVOrigem, rotuloVDestino, peso));
+  }
+
+  void inserirArestaNaoDirecionada(string rotuloVOrigem, string rotuloVDestino, int peso) {
+    lock_guard<mutex> trava(mutexLog);
+    log.push_back(AlteracaoGrafo(AlteracaoGrafo::INSERIR_ARESTA, rotuloVOrigem, rotuloVDestino, peso));
+    log.push_back(AlteracaoGrafo(AlteracaoGrafo::INSERIR_ARESTA, rotuloVDestino, rotuloVOrigem, peso));
+  }
+
+  /**
+   * Remove todas as arestas rotuloVOrigem -> rotuloVDestino
+   * inseridas antes desta chamada.
+   **/
+  void removerAresta(string rotuloVOrigem, string rotuloVDestino) {
+    registrar(AlteracaoGrafo(AlteracaoGrafo::REMOVER_ARESTA, rotuloVOrigem, rotuloVDestino, 0));
+  }
+
+  void removerArestaNaoDirecionada(string rotuloVOrigem, string rotuloVDestino) {
+    lock_guard<mutex> trava(mutexLog);
+    log.push_back(AlteracaoGrafo(AlteracaoGrafo::REMOVER_ARESTA, rotuloVOrigem, rotuloVDestino, 0));
+    log.push_back(AlteracaoGrafo(AlteracaoGrafo::REMOVER_ARESTA, rotuloVDestino, rotuloVOrigem, 0));
+  }
+
+  /**
+   * Aplica as alteracoes registradas ate aqui em uma nova geracao e a
+   * publica. A montagem acontece fora do caminho dos leitores, que
+   * continuam consultando a geracao anterior ate fixarem um novo snapshot.
+   * Alteracoes registradas durante a montagem ficam para a proxima geracao.
+   * Retorna o numero da geracao publicada.
+   **/
+  uint64_t publicar() {
+    lock_guard<mutex> travaPublicacao(mutexPublicacao);
+
+    vector<AlteracaoGrafo> alteracoes;
+    {
+      lock_guard<mutex> travaLog(mutexLog);
+      alteracoes.swap(log);
+    }
+
+    GeracaoGrafo* anterior = atual.load();
+    if (alteracoes.empty()) return anterior->numero;
+
+    GrafoCSR* grafo = aplicar(anterior->grafo, alteracoes);
+
+    // o indice de rotulos eh montado sob demanda; montamos agora para
+    // que os leitores nunca escrevam no grafo
+    grafo->obterIndiceVertice("");
+
+    GeracaoGrafo* nova = new GeracaoGrafo(grafo, anterior->numero + 1);
+    atual.store(nova);
+    anterior->epocaAposentadoria = epocaGlobal.fetch_add(1) + 1;
+    aposentadas.push_back(anterior);
+
+    reciclar();
+    return nova->numero;
+  }
+
+  /**
+   * Quantidade de geracoes antigas ainda nao liberadas, por haver
+   * leitores que podem estar usando-as.
+   **/
+  int getQtdeGeracoesPendentes() {
+    lock_guard<mutex> trava(mutexPublicacao);
+    reciclar();
+    return aposentadas.size();
+  }
+};
+
+SnapshotGrafo::~SnapshotGrafo() {
+  if (dono != NULL) dono->liberarLeitor(leitor);
+}
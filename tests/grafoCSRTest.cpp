@@ -0,0 +1,224 @@
+#include "../src/grafos/grafoCSR.h"
+#include "pch.h"
+using namespace std;
+
+class GrafoCSRTest : public ::testing::Test {
+ protected:
+  virtual void TearDown() {
+    delete (grafo);
+    remove(caminhoArquivo);
+    remove(caminhoBinario);
+  }
+
+  virtual void SetUp() {
+    grafo = NULL;
+  }
+
+  /* Funcao auxiliar para escrever o conteudo de um arquivo de arestas
+   */
+  void escreverArquivo(const string& conteudo) {
+    FILE* arquivo = fopen(caminhoArquivo, "wb");
+    fwrite(conteudo.c_str(), 1, conteudo.size(), arquivo);
+    fclose(arquivo);
+  }
+
+  const char* caminhoArquivo = "grafoCSRTest.txt";
+  const char* caminhoBinario = "grafoCSRTest.bin";
+  GrafoCSR* grafo;
+};
+
+/* Funcao auxiliar para comparar vertices e arestas de dois grafos
+ */
+void expectGrafosIguais(GrafoCSR* g1, GrafoCSR* g2) {
+  ASSERT_EQ(g1->numVertices(), g2->numVertices());
+  ASSERT_EQ(g1->numArestas(), g2->numArestas());
+
+  for (int v = 0; v < g1->numVertices(); v++) {
+    EXPECT_EQ(g1->rotulo(v), g2->rotulo(v));
+    EXPECT_EQ(g1->getOffsets()[v + 1], g2->getOffsets()[v + 1]);
+  }
+  for (int i = 0; i < g1->numArestas(); i++) {
+    EXPECT_EQ(g1->getDestinos()[i], g2->getDestinos()[i]);
+    EXPECT_EQ(g1->getPesos()[i], g2->getPesos()[i]);
+  }
+}
+
+/* Funcao auxiliar para escrever o seguinte grafo ponderado no formato de lista de arestas:
+ * https://github.com/eduardolfalcao/edii/blob/master/conteudos/imgs/grafo-ponderado-representacao-matriz-preenchido.png
+ */
+string arquivoGrafoPonderado() {
+  return "v1 v2 6\nv1 v3 4\nv2 v4 5\nv3 v4 2\nv3 v5 4\nv4 v6 5\nv4 v7 5\nv5 v9 9\nv6 v8 6\nv8 v9 8\n";
+}
+
+TEST_F(GrafoCSRTest, CarregarListaArestasDirecionada) {
+  escreverArquivo(
+      "# comentario no formato SNAP\n"
+      "v1\tv2\t4\n"
+      "v1 v3 2\r\n"
+      "\n"
+      "v3 v2\n"
+      "v4 v1 -3");
+
+  grafo = GrafoCSR::carregarListaArestas(caminhoArquivo, false, 1);
+  ASSERT_NE(grafo, (GrafoCSR*)NULL);
+
+  //os rotulos recebem indices na ordem em que aparecem no arquivo
+  EXPECT_EQ(grafo->numVertices(), 4);
+  EXPECT_EQ(grafo->rotulo(0), "v1");
+  EXPECT_EQ(grafo->rotulo(1), "v2");
+  EXPECT_EQ(grafo->rotulo(2), "v3");
+  EXPECT_EQ(grafo->rotulo(3), "v4");
+  EXPECT_EQ(grafo->numArestas(), 4);
+
+  EXPECT_EQ(grafo->grau(0), 2);
+  EXPECT_EQ(grafo->grau(1), 0);
+  EXPECT_EQ(grafo->grau(2), 1);
+  EXPECT_EQ(grafo->grau(3), 1);
+
+  //vizinhos de v1 ficam ordenados pelo indice do destino
+  EXPECT_EQ(grafo->getDestinos()[0], 1);
+  EXPECT_EQ(grafo->getPesos()[0], 4);
+  EXPECT_EQ(grafo->getDestinos()[1], 2);
+  EXPECT_EQ(grafo->getPesos()[1], 2);
+
+  //arestas sem peso recebem peso 1
+  EXPECT_EQ(grafo->getPesos()[grafo->getOffsets()[2]], 1);
+  EXPECT_EQ(grafo->getPesos()[grafo->getOffsets()[3]], -3);
+
+  EXPECT_TRUE(grafo->saoConectados("v1", "v3"));
+  EXPECT_TRUE(grafo->saoConectados("v4", "v1"));
+  EXPECT_FALSE(grafo->saoConectados("v3", "v1"));
+  EXPECT_FALSE(grafo->saoConectados("v1", "v5"));
+}
+
+TEST_F(GrafoCSRTest, CarregarListaArestasParaleloIgualSequencial) {
+  //arquivo grande o suficiente para ser dividido em varios blocos
+  string conteudo;
+  for (int i = 0; i < 20000; i++) {
+    stringstream sstm;
+    sstm << "v" << i % 3001 << " v" << (i * 7) % 2999 << " " << i % 13 << "\n";
+    conteudo += sstm.str();
+  }
+  escreverArquivo(conteudo);
+
+  GrafoCSR* sequencial = GrafoCSR::carregarListaArestas(caminhoArquivo, true, 1);
+  grafo = GrafoCSR::carregarListaArestas(caminhoArquivo, true, 4);
+
+  EXPECT_EQ(grafo->numArestas(), 40000);
+  expectGrafosIguais(grafo, sequencial);
+
+  delete (sequencial);
+}
+
+TEST_F(GrafoCSRTest, CarregarArquivoInexistente) {
+  EXPECT_EQ(GrafoCSR::carregarListaArestas("naoExiste.txt", false, 1), (GrafoCSR*)NULL);
+}
+
+TEST_F(GrafoCSRTest, CarregarPesoInvalido) {
+  escreverArquivo("v1 v2 4\nv2 v3 4x\n");
+  EXPECT_EQ(GrafoCSR::carregarListaArestas(caminhoArquivo, false, 1), (GrafoCSR*)NULL);
+
+  escreverArquivo("v1 v2 4\nv2 v3 peso\n");
+  EXPECT_EQ(GrafoCSR::carregarListaArestas(caminhoArquivo, false, 1), (GrafoCSR*)NULL);
+
+  //peso que nao cabe em um int
+  escreverArquivo("v1 v2 99999999999\n");
+  EXPECT_EQ(GrafoCSR::carregarListaArestas(caminhoArquivo, false, 1), (GrafoCSR*)NULL);
+}
+
+TEST_F(GrafoCSRTest, SalvarEAbrirBinario) {
+  escreverArquivo(arquivoGrafoPonderado());
+  grafo = GrafoCSR::carregarListaArestas(caminhoArquivo, true, 1);
+  ASSERT_TRUE(grafo->salvarBinario(caminhoBinario));
+
+  GrafoCSR* mapeado = GrafoCSR::abrirBinario(caminhoBinario);
+  ASSERT_NE(mapeado, (GrafoCSR*)NULL);
+  expectGrafosIguais(grafo, mapeado);
+  EXPECT_EQ(mapeado->obterIndiceVertice("v9"), 7);
+  EXPECT_TRUE(mapeado->saoConectados("v9", "v8"));
+
+  //os algoritmos rodam diretamente sobre os vetores mapeados
+  int* distancias = mapeado->bfs("v1");
+  EXPECT_EQ(distancias[mapeado->obterIndiceVertice("v8")], 4);
+  EXPECT_EQ(distancias[mapeado->obterIndiceVertice("v9")], 3);
+  free(distancias);
+
+  distancias = mapeado->dijkstra("v1");
+  EXPECT_EQ(distancias[mapeado->obterIndiceVertice("v4")], 6);
+  EXPECT_EQ(distancias[mapeado->obterIndiceVertice("v8")], 17);
+  EXPECT_EQ(distancias[mapeado->obterIndiceVertice("v9")], 17);
+  free(distancias);
+
+  distancias = mapeado->bellmanFord("v7");
+  EXPECT_EQ(distancias[mapeado->obterIndiceVertice("v1")], 11);
+  EXPECT_EQ(distancias[mapeado->obterIndiceVertice("v9")], 20);
+  free(distancias);
+
+  //78 pois cada aresta nao direcionada eh representada por 2 arestas direcionadas
+  GrafoCSR* mst = mapeado->KruskalMST();
+  int pesoArestas = 0;
+  for (int i = 0; i < mst->numArestas(); i++) pesoArestas += mst->getPesos()[i];
+  EXPECT_EQ(pesoArestas, 78);
+  EXPECT_EQ(mst->numArestas(), 2 * (mst->numVertices() - 1));
+
+  delete (mst);
+  delete (mapeado);
+}
+
+TEST_F(GrafoCSRTest, AbrirBinarioInvalido) {
+  //um arquivo texto nao eh aceito como binario
+  escreverArquivo(arquivoGrafoPonderado());
+  EXPECT_EQ(GrafoCSR::abrirBinario(caminhoArquivo), (GrafoCSR*)NULL);
+  EXPECT_EQ(GrafoCSR::abrirBinario("naoExiste.bin"), (GrafoCSR*)NULL);
+}
+
+/* Funcao auxiliar para sobrescrever um valor em uma posicao de um arquivo
+ */
+template <typename T>
+void sobrescrever(const char* caminho, long posicao, T valor) {
+  FILE* arquivo = fopen(caminho, "r+b");
+  fseek(arquivo, posicao, SEEK_SET);
+  fwrite(&valor, sizeof(T), 1, arquivo);
+  fclose(arquivo);
+}
+
+TEST_F(GrafoCSRTest, AbrirBinarioCorrompido) {
+  escreverArquivo(arquivoGrafoPonderado());
+  grafo = GrafoCSR::carregarListaArestas(caminhoArquivo, true, 1);
+  int64_t v = grafo->numVertices(), e = grafo->numArestas();
+  long inicioOffsets = sizeof(CabecalhoCSR);
+  long inicioDestinos = inicioOffsets + 2 * (v + 1) * sizeof(int64_t);
+
+  //numVertices + 2^60 faz 16 * (numVertices + 1) dar a volta e cair no mesmo tamanho
+  ASSERT_TRUE(grafo->salvarBinario(caminhoBinario));
+  sobrescrever<int64_t>(caminhoBinario, offsetof(CabecalhoCSR, numVertices), v + (1LL << 60));
+  EXPECT_EQ(GrafoCSR::abrirBinario(caminhoBinario), (GrafoCSR*)NULL);
+
+  //offsets que nao terminam em numArestas
+  ASSERT_TRUE(grafo->salvarBinario(caminhoBinario));
+  sobrescrever<int64_t>(caminhoBinario, inicioOffsets + v * sizeof(int64_t), e + 5);
+  EXPECT_EQ(GrafoCSR::abrirBinario(caminhoBinario), (GrafoCSR*)NULL);
+
+  //destino fora do intervalo so eh detectado pela validacao completa,
+  //que so eh pulada se o arquivo for declarado confiavel
+  ASSERT_TRUE(grafo->salvarBinario(caminhoBinario));
+  sobrescrever<int>(caminhoBinario, inicioDestinos, 1000);
+  EXPECT_EQ(GrafoCSR::abrirBinario(caminhoBinario), (GrafoCSR*)NULL);
+  GrafoCSR* semValidacao = GrafoCSR::abrirBinario(caminhoBinario, false);
+  ASSERT_NE(semValidacao, (GrafoCSR*)NULL);
+  EXPECT_FALSE(semValidacao->validar());
+  delete (semValidacao);
+
+  //offset do meio fora de ordem
+  ASSERT_TRUE(grafo->salvarBinario(caminhoBinario));
+  sobrescrever<int64_t>(caminhoBinario, inicioOffsets + sizeof(int64_t), e + 1);
+  EXPECT_EQ(GrafoCSR::abrirBinario(caminhoBinario), (GrafoCSR*)NULL);
+
+  //o arquivo original passa pela validacao completa
+  ASSERT_TRUE(grafo->salvarBinario(caminhoBinario));
+  GrafoCSR* mapeado = GrafoCSR::abrirBinario(caminhoBinario);
+  ASSERT_NE(mapeado, (GrafoCSR*)NULL);
+  expectGrafosIguais(grafo, mapeado);
+  EXPECT_TRUE(grafo->validar());
+  delete (mapeado);
+}
@@ -0,0 +1,136 @@
+#include "../src/grafos/grafoComprimido.h"
+#include "pch.h"
+using namespace std;
+
+class GrafoComprimidoTest : public ::testing::Test {
+ protected:
+  virtual void TearDown() {
+    delete (grafo);
+    delete (csr);
+  }
+
+  virtual void SetUp() {
+    grafo = NULL;
+    csr = NULL;
+  }
+
+  /* Funcao auxiliar para inserir uma aresta nos dois sentidos
+   */
+  void inserirArestaNaoDirecionada(int origem, int destino, int peso) {
+    arestas.push_back(GrafoCSR::Aresta(origem, destino, peso));
+    arestas.push_back(GrafoCSR::Aresta(destino, origem, peso));
+  }
+
+  /* Funcao auxiliar para montar o grafo CSR com os vertices v<ini>, ..., v<fim>
+   * e as arestas inseridas ate aqui, e em seguida comprimi-lo.
+   */
+  void comprimir(int ini, int fim) {
+    vector<string> rotulos;
+    for (int i = ini; i <= fim; i++) rotulos.push_back("v" + to_string(i));
+
+    csr = GrafoCSR::construir(rotulos, arestas);
+    grafo = GrafoComprimido::comprimir(csr);
+  }
+
+  vector<GrafoCSR::Aresta> arestas;
+  GrafoCSR* csr;
+  GrafoComprimido* grafo;
+};
+
+TEST_F(GrafoComprimidoTest, DecodificarIgualCSR) {
+  //diferencas de 1 a 4 bytes, vizinhos com indice menor que o vertice,
+  //arestas paralelas e pesos negativos
+  for (int v = 0; v < 300; v++) {
+    for (int k = 0; k < v % 11; k++) {
+      arestas.push_back(GrafoCSR::Aresta(v, (v * 7919 + k * 104729) % 300, (k % 2 ? -1 : 1) * k * 1000));
+      if (k == 3) arestas.push_back(GrafoCSR::Aresta(v, v, 70000000));
+    }
+  }
+  arestas.push_back(GrafoCSR::Aresta(299, 0, 5));
+  comprimir(0, 299);
+
+  //decodificacao escalar e, se o processador tiver suporte, SSSE3
+  vector<int> vizinhos(grafo->getGrauMaximo() + 4), pesos(grafo->getGrauMaximo() + 4);
+  for (int ssse3 = 0; ssse3 <= 1; ssse3++) {
+    if (grafo->setLeituraSSSE3(ssse3) != (ssse3 == 1)) continue;
+
+    for (int v = 0; v < 300; v++) {
+      int grau = grafo->decodificarVizinhos(v, vizinhos.data());
+      ASSERT_EQ(grau, csr->grau(v));
+      ASSERT_EQ(grafo->decodificarPesos(v, pesos.data()), grau);
+
+      for (int i = 0; i < grau; i++) {
+        EXPECT_EQ(vizinhos[i], csr->getDestinos()[csr->getOffsets()[v] + i]) << ssse3;
+        EXPECT_EQ(pesos[i], csr->getPesos()[csr->getOffsets()[v] + i]) << ssse3;
+      }
+    }
+  }
+}
+
+TEST_F(GrafoComprimidoTest, NavegacaoSobreGrafoComprimido) {
+  //mesmo grafo de 5 componentes usado em grafoNavegacaoTest (v0 a v17)
+  inserirArestaNaoDirecionada(0, 4, 1);
+  inserirArestaNaoDirecionada(0, 8, 1);
+  inserirArestaNaoDirecionada(0, 13, 1);
+  inserirArestaNaoDirecionada(0, 14, 1);
+  inserirArestaNaoDirecionada(1, 5, 1);
+  inserirArestaNaoDirecionada(5, 16, 1);
+  inserirArestaNaoDirecionada(5, 17, 1);
+  inserirArestaNaoDirecionada(3, 9, 1);
+  inserirArestaNaoDirecionada(9, 2, 1);
+  inserirArestaNaoDirecionada(15, 9, 1);
+  inserirArestaNaoDirecionada(15, 2, 1);
+  inserirArestaNaoDirecionada(15, 10, 1);
+  inserirArestaNaoDirecionada(6, 7, 1);
+  inserirArestaNaoDirecionada(6, 11, 1);
+  inserirArestaNaoDirecionada(7, 11, 1);
+  inserirArestaNaoDirecionada(9, 9, 1);
+  comprimir(0, 17);
+
+  int* distancias = grafo->bfs("v3");
+  EXPECT_EQ(distancias[2], 2);
+  EXPECT_EQ(distancias[9], 1);
+  EXPECT_EQ(distancias[10], 3);
+  EXPECT_EQ(distancias[15], 2);
+  EXPECT_EQ(distancias[0], 0);
+  free(distancias);
+
+  EXPECT_TRUE(grafo->haCaminho("v3", "v10"));
+  EXPECT_TRUE(grafo->haCaminho("v17", "v1"));
+  EXPECT_FALSE(grafo->haCaminho("v0", "v1"));
+  EXPECT_FALSE(grafo->haCaminho("v0", "v0"));
+  EXPECT_TRUE(grafo->haCaminho("v9", "v9"));
+  EXPECT_FALSE(grafo->haCaminho("v12", "v5"));
+
+  int componentes[18];
+  EXPECT_EQ(grafo->colorir(componentes), 5);
+  EXPECT_EQ(componentes[4], componentes[0]);
+  EXPECT_EQ(componentes[14], componentes[0]);
+  EXPECT_EQ(componentes[17], componentes[1]);
+  EXPECT_EQ(componentes[10], componentes[3]);
+  EXPECT_EQ(componentes[11], componentes[6]);
+  EXPECT_NE(componentes[12], componentes[0]);
+  EXPECT_NE(componentes[12], componentes[1]);
+  EXPECT_NE(componentes[12], componentes[3]);
+  EXPECT_NE(componentes[12], componentes[6]);
+}
+
+TEST_F(GrafoComprimidoTest, ReducaoDeMemoria) {
+  //malha 100x100 nao ponderada, numerada por linhas
+  int lado = 100;
+  for (int l = 0; l < lado; l++) {
+    for (int c = 0; c < lado; c++) {
+      int v = l * lado + c;
+      if (c + 1 < lado) inserirArestaNaoDirecionada(v, v + 1, 1);
+      if (l + 1 < lado) inserirArestaNaoDirecionada(v, v + lado, 1);
+    }
+  }
+  comprimir(0, lado * lado - 1);
+
+  int64_t bytesCSR = (csr->numVertices() + 1) * sizeof(int64_t) + csr->numArestas() * 2 * sizeof(int);
+  EXPECT_LT(grafo->bytesArestas() * 3, bytesCSR);
+
+  int* distancias = grafo->bfs("v0");
+  EXPECT_EQ(distancias[lado * lado - 1], 2 * (lado - 1));
+  free(distancias);
+}
@@ -190,4 +190,143 @@ TEST_F(GrafoListaAdjTest, SaoConectadosGrafoDirecionado) {
 	EXPECT_FALSE(grafo->saoConectados("v2", "v1"));
 	EXPECT_TRUE(grafo->saoConectados("v3", "v4"));
 	EXPECT_FALSE(grafo->saoConectados("v4", "v3"));
-}
\ No newline at end of file
+}
+
+TEST_F(GrafoListaAdjTest, AcessoVizinhosSemCopia) {
+	inserirVertices(grafo, 1, 4);
+	grafo->inserirArestaDirecionada("v1", "v2", 4);
+	grafo->inserirArestaDirecionada("v1", "v4", 7);
+
+	EXPECT_EQ(grafo->getNumVertices(), 4);
+	EXPECT_EQ(grafo->getRotulo(3), "v4");
+	EXPECT_EQ(grafo->getGrau(0), 2);
+	EXPECT_EQ(grafo->getGrau(1), 0);
+
+	// a visao aponta para a memoria usada internamente pelo grafo
+	GrafoListaAdj::Vizinhos vizinhosV1 = grafo->getVizinhos(0);
+	EXPECT_EQ(vizinhosV1.begin(), grafo->getArestas().at(0).data());
+	EXPECT_EQ(vizinhosV1.size(), 2);
+	EXPECT_EQ(vizinhosV1[1].first, 3);	//indice de v4 eh 3
+	EXPECT_EQ(vizinhosV1[1].second, 7);	//peso eh 7
+	EXPECT_TRUE(grafo->getVizinhos(1).empty());
+
+	// o tipo antigo de getArestas continua disponivel, como copia
+	vector<vector<pair<int, int>>> copia = grafo->getArestas();
+	EXPECT_EQ(copia.size(), 4);
+	EXPECT_EQ(copia[0][1].first, 3);
+	EXPECT_EQ(copia[0][1].second, 7);
+	EXPECT_TRUE(copia[1].empty());
+}
+
+TEST_F(GrafoListaAdjTest, AdjacenciaOrdenadaSemArestasRepetidas) {
+	GrafoListaAdj* ordenado = new GrafoListaAdj(true);
+	inserirVertices(ordenado, 1, 4);
+	ordenado->inserirArestaDirecionada("v1", "v4", 7);
+	ordenado->inserirArestaDirecionada("v1", "v2", 4);
+	ordenado->inserirArestaDirecionada("v1", "v4", 3);
+	ordenado->inserirArestaDirecionada("v1", "v4", 9);
+
+	// a aresta repetida nao eh duplicada e mantem o menor peso
+	vector<pair<int, int>> conexoesV1 = ordenado->getArestas().at(0);
+	EXPECT_EQ(conexoesV1.size(), 2);
+	EXPECT_EQ(conexoesV1.at(0).first, 1);	//indice de v2 eh 1
+	EXPECT_EQ(conexoesV1.at(0).second, 4);
+	EXPECT_EQ(conexoesV1.at(1).first, 3);	//indice de v4 eh 3
+	EXPECT_EQ(conexoesV1.at(1).second, 3);
+
+	EXPECT_TRUE(ordenado->saoConectados("v1", "v4"));
+	EXPECT_FALSE(ordenado->saoConectados("v1", "v3"));
+	EXPECT_FALSE(ordenado->saoConectados("v4", "v1"));
+	delete(ordenado);
+}
+
+TEST_F(GrafoListaAdjTest, AdjacenciaOrdenadaVerticeComGrauAlto) {
+	GrafoListaAdj* ordenado = new GrafoListaAdj(true);
+	inserirVertices(ordenado, 0, 199);
+
+	// v0 ultrapassa LIMIAR_HUB e passa a usar o conjunto hash
+	for (int i = 199; i >= 1; i -= 2) {
+		ordenado->inserirArestaNaoDirecionada("v0", "v" + to_string(i));
+		ordenado->inserirArestaNaoDirecionada("v0", "v" + to_string(i));
+	}
+
+	EXPECT_EQ(ordenado->getGrau(0), 100);
+	for (int i = 1; i < 200; i++) {
+		EXPECT_EQ(ordenado->saoConectados("v0", "v" + to_string(i)), i % 2 == 1);
+		EXPECT_EQ(ordenado->saoConectados("v" + to_string(i), "v0"), i % 2 == 1);
+	}
+	for (int i = 1; i < ordenado->getGrau(0); i++) {
+		EXPECT_LT(ordenado->getVizinhos(0)[i - 1].first, ordenado->getVizinhos(0)[i].first);
+	}
+	delete(ordenado);
+}
+
+TEST_F(GrafoListaAdjTest, ListasDeVizinhosCrescemAlemDoInline) {
+	inserirVertices(grafo, 0, 99);
+
+	// v0 passa por varias capacidades; v1 usa apenas o espaco inline
+	for (int i = 1; i < 100; i++) grafo->inserirArestaDirecionada("v0", "v" + to_string(i), i);
+	grafo->inserirArestaDirecionada("v1", "v2", 5);
+	for (int i = 2; i < 100; i++) grafo->inserirArestaDirecionada("v" + to_string(i), "v0", i);
+
+	EXPECT_EQ(grafo->getGrau(0), 99);
+	EXPECT_EQ(grafo->getGrau(1), 1);
+	for (int i = 1; i < 100; i++) {
+		EXPECT_EQ(grafo->getVizinhos(0)[i - 1].first, i);
+		EXPECT_EQ(grafo->getVizinhos(0)[i - 1].second, i);
+	}
+	EXPECT_EQ(grafo->getVizinhos(1)[0].first, 2);
+	EXPECT_EQ(grafo->getVizinhos(50)[0].second, 50);
+	EXPECT_TRUE(grafo->saoConectados("v99", "v0"));
+	EXPECT_EQ(grafo->getArestas().at(0).size(), 99);
+}
+
+TEST_F(GrafoListaAdjTest, InsercaoArestasEmLoteIgualUmaAUma) {
+	GrafoListaAdj* grafoUmaAUma = new GrafoListaAdj();
+	inserirVertices(grafo, 0, 199);
+	inserirVertices(grafoUmaAUma, 0, 199);
+
+	vector<EspecAresta> especs;
+	for (int i = 0; i < 2000; i++) {
+		string origem = "v" + to_string((i * 37) % 200);
+		string destino = "v" + to_string((i * 101 + i / 7) % 200);
+		especs.push_back(EspecAresta(origem, destino, i));
+		grafoUmaAUma->inserirArestaNaoDirecionada(origem, destino, i);
+	}
+	//rotulo inexistente: aresta ignorada
+	especs.push_back(EspecAresta("v0", "v999", 1));
+
+	grafo->inserirArestas(especs, true, 3);
+
+	for (int v = 0; v < 200; v++) {
+		ASSERT_EQ(grafo->getGrau(v), grafoUmaAUma->getGrau(v));
+		for (int i = 0; i < grafo->getGrau(v); i++) {
+			EXPECT_EQ(grafo->getVizinhos(v)[i], grafoUmaAUma->getVizinhos(v)[i]);
+		}
+	}
+	delete(grafoUmaAUma);
+}
+
+TEST_F(GrafoListaAdjTest, InsercaoArestasIdxAdjacenciaOrdenada) {
+	delete(grafo);
+	grafo = new GrafoListaAdj(true);
+	inserirVertices(grafo, 0, 99);
+	grafo->inserirArestaDirecionada("v0", "v50", 7);
+
+	//v0 vira hub; as arestas repetidas ficam com o menor peso
+	vector<EspecArestaIdx> especs;
+	for (int i = 99; i >= 1; i--) especs.push_back(EspecArestaIdx(0, i, i));
+	especs.push_back(EspecArestaIdx(0, 10, 3));
+	especs.push_back(EspecArestaIdx(5, 0, 2));
+	especs.push_back(EspecArestaIdx(5, 100, 2));
+	grafo->inserirArestasIdx(especs, false, 2);
+
+	EXPECT_EQ(grafo->getGrau(0), 99);
+	for (int i = 1; i < 99; i++) EXPECT_LT(grafo->getVizinhos(0)[i - 1].first, grafo->getVizinhos(0)[i].first);
+	EXPECT_EQ(grafo->getVizinhos(0)[9].second, 3);
+	EXPECT_EQ(grafo->getVizinhos(0)[49].second, 7);
+	EXPECT_EQ(grafo->getGrau(5), 1);
+	EXPECT_TRUE(grafo->saoConectados("v0", "v99"));
+	EXPECT_TRUE(grafo->saoConectados("v5", "v0"));
+	EXPECT_FALSE(grafo->saoConectados("v0", "v0"));
+}
@@ -300,4 +300,260 @@ TEST_F(MenorCaminhoTest, DijkstraGrafoSemCicloNegativo) {
   EXPECT_EQ(distancias[7], 8);
   EXPECT_EQ(distancias[8], 0);
   free(distancias);
-}
\ No newline at end of file
+}
+
+TEST_F(MenorCaminhoTest, DijkstraGrafoComCicloNegativo) {
+  //a -> b -> c -> b, com b -> c -> b negativo
+  grafo->inserirVertice("a");
+  grafo->inserirVertice("b");
+  grafo->inserirVertice("c");
+  grafo->inserirArestaDirecionada("a", "b", 1);
+  grafo->inserirArestaDirecionada("b", "c", -5);
+  grafo->inserirArestaDirecionada("c", "b", 1);
+
+  //as distancias nao sao confiaveis, mas a busca termina
+  //e cada vertice eh finalizado uma unica vez
+  EspacoBusca espaco;
+  EXPECT_EQ(grafo->dijkstra("a", espaco), 3);
+  EXPECT_EQ(espaco.fila[0], 0);
+  EXPECT_EQ(espaco.fila[1], 1);
+  EXPECT_EQ(espaco.fila[2], 2);
+  EXPECT_EQ(espaco.distancias[1], 1);
+  EXPECT_EQ(espaco.distancias[2], -4);
+
+  int* distancias = grafo->dijkstra("a");
+  EXPECT_EQ(distancias[2], -4);
+  free(distancias);
+}
+
+/* Funcao auxiliar para obter a distancia de um vertice a partir do seu
+ * rotulo, ja que os indices mudam depois de reordenar o grafo.
+ */
+int distanciaPorRotulo(GrafoListaAdj* grafo, int* distancias, string rotulo) {
+  for (int i = 0; i < grafo->getVertices().size(); i++) {
+    if (grafo->getVertices().at(i) == rotulo) return distancias[i];
+  }
+  return -1;
+}
+
+TEST_F(MenorCaminhoTest, ReordenarPreservaDistancias) {
+  EstrategiaReordenacao estrategias[] = {REORDENAR_RCM, REORDENAR_GRAU, REORDENAR_BFS};
+  int esperadoDijkstra[] = {0, 6, 4, 6, 8, 11, 11, 17, 17};
+  int esperadoBfs[] = {0, 1, 1, 2, 2, 3, 3, 4, 3};
+
+  for (EstrategiaReordenacao estrategia : estrategias) {
+    GrafoListaAdj* reordenado = new GrafoListaAdj();
+    inserirVertices(reordenado, 1, 9);
+    construirGrafoPonderado(reordenado);
+
+    vector<int> novosIndices = reordenado->reordenar(estrategia);
+
+    //a permutacao usa cada indice uma unica vez
+    vector<bool> usado(9, false);
+    for (int i = 0; i < 9; i++) {
+      ASSERT_FALSE(usado[novosIndices[i]]);
+      usado[novosIndices[i]] = true;
+      EXPECT_EQ(reordenado->getVertices().at(novosIndices[i]), "v" + to_string(i + 1));
+    }
+
+    int* distancias = reordenado->dijkstra("v1");
+    int* distanciasBfs = reordenado->bfs("v1");
+    for (int i = 0; i < 9; i++) {
+      EXPECT_EQ(distanciaPorRotulo(reordenado, distancias, "v" + to_string(i + 1)), esperadoDijkstra[i]);
+      EXPECT_EQ(distanciaPorRotulo(reordenado, distanciasBfs, "v" + to_string(i + 1)), esperadoBfs[i]);
+    }
+    EXPECT_TRUE(reordenado->saoConectados("v8", "v9"));
+    free(distancias);
+    free(distanciasBfs);
+    delete (reordenado);
+  }
+}
+
+TEST_F(MenorCaminhoTest, ReordenarPorGrau) {
+  inserirVertices(grafo, 1, 9);
+  construirGrafoPonderado(grafo);
+  grafo->reordenar(REORDENAR_GRAU);
+
+  //v4 eh o vertice de maior grau (v2, v3, v6 e v7)
+  EXPECT_EQ(grafo->getVertices().at(0), "v4");
+  for (int i = 1; i < 9; i++) EXPECT_GE(grafo->getGrau(i - 1), grafo->getGrau(i));
+}
+
+TEST_F(MenorCaminhoTest, RemoverVerticeEAresta) {
+  inserirVertices(grafo, 1, 9);
+  construirGrafoPonderado(grafo);
+
+  //sem v3, o caminho ate v4 passa por v2 e o ate v5 da a volta por v9
+  grafo->removerVertice("v3");
+  grafo->removerArestaNaoDirecionada("v4", "v7");
+  EXPECT_FALSE(grafo->haCaminho("v1", "v3"));
+  EXPECT_FALSE(grafo->haCaminho("v1", "v7"));
+  EXPECT_TRUE(grafo->haCaminho("v1", "v5"));
+
+  int* distancias = grafo->dijkstra("v1");
+  EXPECT_EQ(distancias[2], POS_INF);  //v3 foi removido
+  EXPECT_EQ(distancias[3], 11);
+  EXPECT_EQ(distancias[4], 39);
+  EXPECT_EQ(distancias[6], POS_INF);
+  free(distancias);
+
+  distancias = grafo->bellmanFord("v1");
+  EXPECT_EQ(distancias[4], 39);
+  EXPECT_EQ(distancias[6], POS_INF);
+  free(distancias);
+
+  distancias = grafo->bfs("v1");
+  EXPECT_EQ(distancias[2], 0);
+  EXPECT_EQ(distancias[4], 6);  //v1-v2-v4-v6-v8-v9-v5
+  free(distancias);
+
+  //v3 e v7 formam dois componentes a parte, mas v3 nao conta mais
+  EXPECT_EQ(grafo->colorir(), 2);
+}
+
+TEST_F(MenorCaminhoTest, CompactarAposRemocoes) {
+  inserirVertices(grafo, 1, 9);
+  construirGrafoPonderado(grafo);
+  grafo->setLimiarCompactacao(0.5);
+
+  //1 vertice e 6 arestas (3 de saida e 3 de chegada) de 29: ainda nao compacta
+  grafo->removerVertice("v3");
+  EXPECT_TRUE(grafo->estaRemovido(2));
+  EXPECT_EQ(grafo->getVertices().size(), 9);
+
+  //o rotulo removido pode voltar como um vertice novo
+  grafo->inserirVertice("v3");
+  grafo->inserirArestaDirecionada("v9", "v3", 1);
+  EXPECT_EQ(grafo->getVertices().size(), 10);
+
+  vector<int> novosIndices = grafo->reordenar(REORDENAR_BFS);
+  EXPECT_EQ(novosIndices[2], -1);
+  EXPECT_EQ(grafo->getVertices().size(), 9);
+  for (int i = 0; i < 10; i++) {
+    if (i != 2) {
+      EXPECT_EQ(grafo->getVertices().at(novosIndices[i]), i == 9 ? "v3" : "v" + to_string(i + 1));
+    }
+  }
+
+  int* distancias = grafo->dijkstra("v1");
+  EXPECT_EQ(distanciaPorRotulo(grafo, distancias, "v3"), 31);  //v1-v2-v4-v6-v8-v9-v3
+  EXPECT_EQ(distanciaPorRotulo(grafo, distancias, "v7"), 16);
+  free(distancias);
+
+  //v4 tem 3 arestas de saida e 3 de chegada: 7 tombstones de 24 vertices e arestas
+  grafo->setLimiarCompactacao(0.3);
+  grafo->removerVertice("v4");
+  EXPECT_EQ(grafo->getVertices().size(), 9);
+  grafo->removerVertice("v2");
+  EXPECT_EQ(grafo->getVertices().size(), 7);
+}
+
+TEST_F(MenorCaminhoTest, HaCaminhoCaminhoLongo) {
+  //com a dfs recursiva, um caminho deste tamanho estoura a pilha
+  int n = 300000;
+  inserirVertices(grafo, 0, n - 1);
+  for (int i = 0; i + 1 < n; i++) grafo->inserirArestaDirecionada("v" + to_string(i), "v" + to_string(i + 1));
+
+  EXPECT_TRUE(grafo->haCaminho("v0", "v" + to_string(n - 1)));
+  EXPECT_FALSE(grafo->haCaminho("v" + to_string(n - 1), "v0"));
+  EXPECT_FALSE(grafo->haCaminho("v0", "v-1"));
+  EXPECT_EQ(grafo->colorir(), 1);
+}
+
+TEST_F(MenorCaminhoTest, EspacoBuscaReaproveitado) {
+  inserirVertices(grafo, 1, 10);
+  construirGrafoPonderado(grafo);
+  EspacoBusca espaco;
+
+  for (int o = 1; o <= 10; o++) {
+    string origem = "v" + to_string(o);
+    int* esperadoDijkstra = grafo->dijkstra(origem);
+    int* esperadoBfs = grafo->bfs(origem);
+
+    //v10 esta isolado
+    EXPECT_EQ(grafo->dijkstra(origem, espaco), o == 10 ? 1 : 9);
+    for (int v = 0; v < 10; v++) {
+      EXPECT_EQ(espaco.visitado(v) ? espaco.distancias[v] : POS_INF, esperadoDijkstra[v]) << origem << " " << v;
+    }
+
+    //vertices saem do dijkstra em ordem de distancia
+    for (int i = 1; i < espaco.fila.size(); i++) {
+      EXPECT_LE(espaco.distancias[espaco.fila[i - 1]], espaco.distancias[espaco.fila[i]]);
+    }
+
+    grafo->bfs(origem, espaco);
+    for (int v = 0; v < 10; v++) EXPECT_EQ(espaco.visitado(v) ? espaco.distancias[v] : 0, esperadoBfs[v]);
+
+    free(esperadoDijkstra);
+    free(esperadoBfs);
+  }
+
+  EXPECT_TRUE(grafo->haCaminho("v1", "v9", espaco));
+  EXPECT_FALSE(grafo->haCaminho("v1", "v10", espaco));
+  EXPECT_EQ(grafo->dijkstra("v0", espaco), -1);
+  EXPECT_EQ(grafo->dijkstra("v0"), (int*)NULL);
+  int componentes[10];
+  EXPECT_EQ(grafo->colorir(componentes, espaco), 2);
+  EXPECT_EQ(componentes[0], 1);
+  EXPECT_EQ(componentes[9], 2);
+
+  //os rotulos nao sao alterados
+  EXPECT_EQ(grafo->getVertices().at(9), "v10");
+  EXPECT_TRUE(grafo->haCaminho("v1", "v9", espaco));
+}
+
+/* Funcao auxiliar que retorna o peso da aresta origem -> destino,
+ * ou -1 se ela nao existir.
+ */
+int pesoAresta(GrafoListaAdj* grafo, int origem, int destino) {
+  for (const pair<int, int>& aresta : grafo->getVizinhos(origem)) {
+    if (aresta.first == destino) return aresta.second;
+  }
+  return -1;
+}
+
+TEST_F(MenorCaminhoTest, CaminhosPorPredecessores) {
+  inserirVertices(grafo, 1, 10);
+  construirGrafoPonderado(grafo);
+
+  int predecessores[10], caminho[10];
+  int* distancias = grafo->dijkstra("v1", predecessores);
+
+  //v1 -> v3 -> v5 -> v9
+  EXPECT_EQ(GrafoListaAdj::reconstruirCaminho(predecessores, 8, caminho), 4);
+  EXPECT_EQ(caminho[0], 0);
+  EXPECT_EQ(caminho[1], 2);
+  EXPECT_EQ(caminho[2], 4);
+  EXPECT_EQ(caminho[3], 8);
+  EXPECT_EQ(GrafoListaAdj::reconstruirCaminho(predecessores, 0, caminho), 1);
+  EXPECT_EQ(GrafoListaAdj::reconstruirCaminho(predecessores, 9, caminho), -1);
+
+  //o peso de cada caminho eh a distancia
+  for (int v = 0; v < 9; v++) {
+    int tamanho = GrafoListaAdj::reconstruirCaminho(predecessores, v, caminho);
+    int soma = 0;
+    for (int i = 1; i < tamanho; i++) soma += pesoAresta(grafo, caminho[i - 1], caminho[i]);
+    EXPECT_EQ(soma, distancias[v]) << v;
+  }
+  free(distancias);
+
+  //bfs: cada caminho tem distancia + 1 vertices
+  distancias = grafo->bfs("v9", predecessores);
+  for (int v = 0; v < 9; v++) {
+    int tamanho = GrafoListaAdj::reconstruirCaminho(predecessores, v, caminho);
+    EXPECT_EQ(tamanho, distancias[v] + 1);
+    EXPECT_EQ(caminho[0], 8);
+    for (int i = 1; i < tamanho; i++) EXPECT_NE(pesoAresta(grafo, caminho[i - 1], caminho[i]), -1);
+  }
+  free(distancias);
+
+  //com espaco de trabalho
+  EspacoBusca espaco;
+  grafo->dijkstra("v7", espaco);
+  EXPECT_EQ(espaco.caminhoAte(7, caminho), 4);  //v7 -> v4 -> v6 -> v8
+  EXPECT_EQ(caminho[1], 3);
+  EXPECT_EQ(caminho[2], 5);
+  EXPECT_EQ(espaco.caminhoAte(9, caminho), -1);
+  grafo->bfs("v7", espaco);
+  EXPECT_EQ(espaco.caminhoAte(0, caminho), espaco.distancias[0] + 1);
+}
@@ -69,12 +69,15 @@ TEST_F(GrafoListaAdjNavegacaoTest, colorirGrafo1Comp) {
   inserirVertices(grafo, 1, 9);
   construirGrafoNaoPonderado(grafo);
 
-  EXPECT_EQ(grafo->colorir(), 1);
+  int componentes[9];
+  EXPECT_EQ(grafo->colorir(componentes), 1);
   for (int i = 1; i <= 8; i++) {
-    //depois de colorir o grafo, todos os rotulos
-    //dos vertices devem estar iguais
-    EXPECT_EQ(grafo->getVertices().at(i - 1), grafo->getVertices().at(i));
+    //depois de colorir o grafo, todos os vertices
+    //devem estar no mesmo componente
+    EXPECT_EQ(componentes[i - 1], componentes[i]);
   }
+  //os rotulos nao sao alterados
+  EXPECT_EQ(grafo->getRotulo(0), "v1");
 }
 
 /* Funcao auxiliar para construir o seguinte grafo grafo de 5 componentes:
@@ -114,43 +117,44 @@ TEST_F(GrafoListaAdjNavegacaoTest, colorirGrafo5Comp) {
   construirGrafoCom5Componentes(grafo);
 
   //verifico que o grafo tem 5 componentes
-  EXPECT_EQ(grafo->colorir(), 5);
+  int componentes[18];
+  EXPECT_EQ(grafo->colorir(componentes), 5);
 
   //verifico que os vertices 0, 4, 8, 13, e 14 pertencem ao mesmo componente
-  //por isso, depois da coloracao, esses vertices possuirao o mesmo rotulo
-  string corComp1 = grafo->getVertices().at(0);
-  EXPECT_EQ(grafo->getVertices().at(4), corComp1);
-  EXPECT_EQ(grafo->getVertices().at(8), corComp1);
-  EXPECT_EQ(grafo->getVertices().at(13), corComp1);
-  EXPECT_EQ(grafo->getVertices().at(14), corComp1);
+  //por isso, depois da coloracao, esses vertices possuirao a mesma cor
+  int corComp1 = componentes[0];
+  EXPECT_EQ(componentes[4], corComp1);
+  EXPECT_EQ(componentes[8], corComp1);
+  EXPECT_EQ(componentes[13], corComp1);
+  EXPECT_EQ(componentes[14], corComp1);
 
   //verifico que os vertices 1, 5, 16, e 17 pertencem ao mesmo componente
-  //por isso, depois da coloracao, esses vertices possuirao o mesmo rotulo
-  string corComp2 = grafo->getVertices().at(1);
-  EXPECT_EQ(grafo->getVertices().at(5), corComp2);
-  EXPECT_EQ(grafo->getVertices().at(16), corComp2);
-  EXPECT_EQ(grafo->getVertices().at(17), corComp2);
+  //por isso, depois da coloracao, esses vertices possuirao a mesma cor
+  int corComp2 = componentes[1];
+  EXPECT_EQ(componentes[5], corComp2);
+  EXPECT_EQ(componentes[16], corComp2);
+  EXPECT_EQ(componentes[17], corComp2);
 
   //verifico que os vertices 2, 3, 9, 10, e 15 pertencem ao mesmo componente
-  //por isso, depois da coloracao, esses vertices possuirao o mesmo rotulo
-  string corComp3 = grafo->getVertices().at(3);
-  EXPECT_EQ(grafo->getVertices().at(9), corComp3);
-  EXPECT_EQ(grafo->getVertices().at(15), corComp3);
-  EXPECT_EQ(grafo->getVertices().at(2), corComp3);
-  EXPECT_EQ(grafo->getVertices().at(10), corComp3);
+  //por isso, depois da coloracao, esses vertices possuirao a mesma cor
+  int corComp3 = componentes[3];
+  EXPECT_EQ(componentes[9], corComp3);
+  EXPECT_EQ(componentes[15], corComp3);
+  EXPECT_EQ(componentes[2], corComp3);
+  EXPECT_EQ(componentes[10], corComp3);
 
   //verifico que os vertices 6, 7, e 11 pertencem ao mesmo componente
-  //por isso, depois da coloracao, esses vertices possuirao o mesmo rotulo
-  string corComp4 = grafo->getVertices().at(6);
-  EXPECT_EQ(grafo->getVertices().at(7), corComp4);
-  EXPECT_EQ(grafo->getVertices().at(11), corComp4);
+  //por isso, depois da coloracao, esses vertices possuirao a mesma cor
+  int corComp4 = componentes[6];
+  EXPECT_EQ(componentes[7], corComp4);
+  EXPECT_EQ(componentes[11], corComp4);
 
-  //verifico que o vertice 12 possui rotulo diferente dos rotulos
+  //verifico que o vertice 12 possui cor diferente das cores
   //dos vertices que estao nos componentes 1, 2, 3, e 4
-  EXPECT_NE(grafo->getVertices().at(12), corComp1);
-  EXPECT_NE(grafo->getVertices().at(12), corComp2);
-  EXPECT_NE(grafo->getVertices().at(12), corComp3);
-  EXPECT_NE(grafo->getVertices().at(12), corComp4);
+  EXPECT_NE(componentes[12], corComp1);
+  EXPECT_NE(componentes[12], corComp2);
+  EXPECT_NE(componentes[12], corComp3);
+  EXPECT_NE(componentes[12], corComp4);
 }
 
 TEST_F(GrafoListaAdjNavegacaoTest, bfsGrafo1CompNaoPonderado) {
@@ -269,4 +273,784 @@ TEST_F(GrafoListaAdjNavegacaoTest, bfsGrafo5CompNaoPonderado) {
   EXPECT_EQ(distancias[16], 0);
   EXPECT_EQ(distancias[17], 0);
   free(distancias);
-}
\ No newline at end of file
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, removerVerticeEAresta) {
+  inserirVertices(grafo, 1, 9);
+  construirGrafoNaoPonderado(grafo);
+
+  //v4 eh o unico caminho de v1 ate v7
+  grafo->removerVertice("v4");
+  EXPECT_FALSE(grafo->haCaminho("v1", "v7"));
+  EXPECT_FALSE(grafo->saoConectados("v2", "v4"));
+  EXPECT_TRUE(grafo->haCaminho("v1", "v8"));
+
+  int* distancias = grafo->bfs("v1");
+  EXPECT_EQ(distancias[3], 0);  //v4 foi removido
+  EXPECT_EQ(distancias[5], 5);  //v6 agora eh alcancado por v3-v5-v9-v8
+  EXPECT_EQ(distancias[6], 0);  //v7 ficou isolado
+  free(distancias);
+
+  grafo->removerArestaNaoDirecionada("v5", "v9");
+  EXPECT_FALSE(grafo->saoConectados("v5", "v9"));
+  EXPECT_FALSE(grafo->haCaminho("v1", "v8"));
+
+  //componentes: {v1,v2,v3,v5}, {v6,v8,v9}, {v7}
+  EXPECT_EQ(grafo->colorir(), 3);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, compactarAposRemocoes) {
+  inserirVertices(grafo, 1, 9);
+  construirGrafoNaoPonderado(grafo);
+
+  grafo->removerVertice("v2");
+  grafo->removerAresta("v3", "v5");
+
+  vector<int> novosIndices = grafo->compactar();
+  EXPECT_EQ(novosIndices[0], 0);
+  EXPECT_EQ(novosIndices[1], -1);
+  EXPECT_EQ(novosIndices[2], 1);
+  EXPECT_EQ(novosIndices[8], 7);
+
+  EXPECT_EQ(grafo->getVertices().size(), 8);
+  EXPECT_EQ(grafo->getVertices()[1], "v3");
+  EXPECT_EQ(grafo->getArestas().at(0).size(), 1);  //v1 so tem v3 como vizinho
+  EXPECT_EQ(grafo->getArestas().at(1).size(), 2);  //v3: v1 e v4
+  EXPECT_TRUE(grafo->saoConectados("v5", "v3"));
+  EXPECT_FALSE(grafo->saoConectados("v3", "v5"));
+
+  int* distancias = grafo->bfs("v1");
+  EXPECT_EQ(distancias[2], 2);  //v4
+  EXPECT_EQ(distancias[6], 4);  //v8
+  free(distancias);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, compactarPorLimiar) {
+  inserirVertices(grafo, 1, 9);
+  construirGrafoNaoPonderado(grafo);
+  grafo->setLimiarCompactacao(0.2);
+
+  //9 vertices e 22 arestas: a remocao de v1 gera 5 tombstones
+  //(o vertice, 2 arestas de saida e 2 de chegada)
+  grafo->removerVertice("v1");
+  EXPECT_EQ(grafo->getVertices().size(), 9);
+
+  //mais 3: v2, v2 -> v4 e v4 -> v2 (v2 -> v1 ja foi contada)
+  grafo->removerVertice("v2");
+  EXPECT_EQ(grafo->getVertices().size(), 7);
+  EXPECT_EQ(grafo->getVertices()[0], "v3");
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, compactarContaArestasDeChegada) {
+  inserirVertices(grafo, 0, 20);
+  for (int i = 1; i <= 20; i++) grafo->inserirArestaDirecionada("v" + to_string(i), "v0");
+  grafo->setLimiarCompactacao(0.5);
+
+  //v0 nao tem arestas de saida, mas as 20 que chegam nele viram tombstones
+  grafo->removerVertice("v0");
+  EXPECT_EQ(grafo->getVertices().size(), 20);
+  EXPECT_EQ(grafo->getVertices()[0], "v1");
+  for (int i = 0; i < 20; i++) EXPECT_EQ(grafo->getArestas().at(i).size(), 0);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, rotulosInternados) {
+  inserirVertices(grafo, 1, 9);
+  construirGrafoNaoPonderado(grafo);
+
+  //rotulos repetidos nao criam vertices nem entradas novas no pool
+  grafo->inserirVertice("v3");
+  EXPECT_EQ(grafo->getNumVertices(), 9);
+  EXPECT_EQ(grafo->getPoolRotulos().size(), 9);
+  EXPECT_EQ(grafo->getRotulo(2), "v3");
+
+  //o id do rotulo se mantem apos a compactacao, mesmo mudando o indice
+  int idV5 = grafo->getIdRotulo(4);
+  grafo->removerVertice("v2");
+  grafo->compactar();
+  EXPECT_EQ(grafo->getRotulo(3), "v5");
+  EXPECT_EQ(grafo->getIdRotulo(3), idV5);
+  EXPECT_TRUE(grafo->saoConectados("v3", "v5"));
+
+  //reinserir um rotulo removido reaproveita seu id
+  grafo->inserirVertice("v2");
+  EXPECT_EQ(grafo->getNumVertices(), 9);
+  EXPECT_EQ(grafo->getPoolRotulos().size(), 9);
+  EXPECT_EQ(grafo->getRotulo(8), "v2");
+  EXPECT_FALSE(grafo->saoConectados("v1", "v2"));
+
+  //rotulos longos tambem ficam no pool, sem uma alocacao por vertice
+  for (int i = 0; i < 1000; i++) grafo->inserirVertice("vertice-com-rotulo-longo-" + to_string(i));
+  EXPECT_EQ(grafo->getNumVertices(), 1009);
+  EXPECT_EQ(grafo->getRotulo(1008), "vertice-com-rotulo-longo-999");
+  EXPECT_TRUE(grafo->haCaminho("v1", "v9"));
+
+  //getVertices le os rotulos direto do pool, sem copiar
+  GrafoListaAdj::Rotulos vertices = grafo->getVertices();
+  EXPECT_EQ(vertices.size(), 1009);
+  EXPECT_EQ(vertices[8].data(), grafo->getRotulo(8).data());
+  int i = 0;
+  for (string_view rotulo : vertices) EXPECT_EQ(rotulo, grafo->getRotulo(i++));
+  EXPECT_EQ(i, 1009);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, dfsPreEPosOrdem) {
+  inserirVertices(grafo, 1, 9);
+  construirGrafoNaoPonderado(grafo);
+
+  EspacoBusca espaco;
+  vector<int> pre, pos;
+  espaco.preparar(grafo->getNumVertices());
+  EXPECT_TRUE(grafo->dfs(
+      0, espaco,
+      [&](int v) {
+        pre.push_back(v);
+        return true;
+      },
+      [&](int v) { pos.push_back(v); }));
+
+  //mesma ordem da dfs recursiva: v1 v2 v4 v3 v5 v9 v8 v6 v7
+  vector<int> preEsperada = {0, 1, 3, 2, 4, 8, 7, 5, 6};
+  EXPECT_EQ(pre, preEsperada);
+  EXPECT_EQ(pos.size(), 9);
+  EXPECT_EQ(pos.back(), 0);
+  EXPECT_EQ(pos.front(), 5);  //v6 eh o primeiro a terminar
+
+  //interrompendo a busca ao descobrir v5
+  espaco.preparar(grafo->getNumVertices());
+  EXPECT_FALSE(grafo->dfs(0, espaco, [](int v) { return v != 4; }));
+  EXPECT_FALSE(espaco.visitado(6));
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, haCaminhoCaminhoLongo) {
+  //com a dfs recursiva, um caminho deste tamanho estoura a pilha
+  int n = 300000;
+  inserirVertices(grafo, 0, n - 1);
+  for (int i = 0; i + 1 < n; i++) grafo->inserirArestaNaoDirecionada("v" + to_string(i), "v" + to_string(i + 1));
+
+  EXPECT_TRUE(grafo->haCaminho("v0", "v" + to_string(n - 1)));
+  EXPECT_TRUE(grafo->haCaminho("v" + to_string(n - 1), "v0"));
+  EXPECT_EQ(grafo->colorir(), 1);
+}
+
+/* Funcao auxiliar para construir um grafo de 2000 vertices com hubs
+ * e diametro pequeno, em que dois tercos das arestas sao direcionadas.
+ */
+void construirGrafoSocial(GrafoListaAdj* grafo) {
+  inserirVertices(grafo, 0, 1999);
+  unsigned int semente = 7;
+  for (int v = 1; v < 2000; v++) {
+    for (int k = 0; k < 3; k++) {
+      semente = semente * 1103515245 + 12345;
+      int u = (semente >> 8) % (v < 50 ? v : 50 + v / 10);
+      if (k == 0)
+        grafo->inserirArestaNaoDirecionada("v" + to_string(v), "v" + to_string(u));
+      else
+        grafo->inserirArestaDirecionada("v" + to_string(k == 1 ? u : v), "v" + to_string(k == 1 ? v : u));
+    }
+  }
+}
+
+/* Funcao auxiliar que compara bfsDirecaoOtimizada com bfs
+ * partindo de cada uma das origens.
+ */
+void expectBfsIguais(GrafoListaAdj* grafo, const vector<string>& origens) {
+  for (const string& origem : origens) {
+    int* esperadas = grafo->bfs(origem);
+    int* distancias = grafo->bfsDirecaoOtimizada(origem);
+    for (int i = 0; i < grafo->getNumVertices(); i++) EXPECT_EQ(distancias[i], esperadas[i]) << origem << " " << i;
+    free(esperadas);
+    free(distancias);
+  }
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, bfsDirecaoOtimizadaIgualBfs) {
+  inserirVertices(grafo, 0, 17);
+  construirGrafoCom5Componentes(grafo);
+  expectBfsIguais(grafo, {"v0", "v1", "v3", "v11", "v12"});
+  EXPECT_EQ(grafo->bfsDirecaoOtimizada("v99"), (int*)NULL);
+
+  //grafo com hubs e diametro pequeno, para que a busca passe pelo modo bottom-up
+  GrafoListaAdj* social = new GrafoListaAdj();
+  construirGrafoSocial(social);
+  expectBfsIguais(social, {"v0", "v7", "v1999", "v1000"});
+
+  //a adjacencia reversa eh refeita depois de remocoes
+  social->removerVertice("v1");
+  social->removerAresta("v0", "v2");
+  social->inserirArestaDirecionada("v1999", "v3");
+  expectBfsIguais(social, {"v0", "v1999", "v500"});
+  delete (social);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, bfsParalelaIgualBfs) {
+  construirGrafoSocial(grafo);
+  grafo->removerVertice("v3");
+  grafo->inserirVertice("isolado");
+
+  for (string origem : {"v0", "v1999", "v42", "isolado"}) {
+    int* esperadas = grafo->bfs(origem);
+    for (int numThreads = 1; numThreads <= 4; numThreads++) {
+      int* distancias = grafo->bfsParalela(origem, numThreads);
+      for (int i = 0; i < grafo->getNumVertices(); i++) ASSERT_EQ(distancias[i], esperadas[i]) << origem << " " << i;
+      free(distancias);
+    }
+    free(esperadas);
+  }
+  EXPECT_EQ(grafo->bfsParalela("v3", 2), (int*)NULL);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, bfsMultiplasOrigensIgualBfs) {
+  construirGrafoSocial(grafo);
+  grafo->removerAresta("v0", "v1");
+
+  //mais de um lote de buscas, com uma origem repetida
+  vector<string> origens;
+  for (int i = 0; i < 150; i++) origens.push_back("v" + to_string(i * 13));
+  origens.push_back("v0");
+
+  int numVertices = grafo->getNumVertices();
+  vector<int> distancias(origens.size() * numVertices, -1);
+  EXPECT_EQ(grafo->bfsMultiplasOrigens(origens, distancias.data()), 0);
+
+  for (int i = 0; i < origens.size(); i++) {
+    int* esperadas = grafo->bfs(origens[i]);
+    for (int v = 0; v < numVertices; v++) ASSERT_EQ(distancias[i * numVertices + v], esperadas[v]) << origens[i] << " " << v;
+    free(esperadas);
+  }
+
+  origens.push_back("v5000");
+  EXPECT_EQ(grafo->bfsMultiplasOrigens(origens, distancias.data()), -1);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, haCaminhoBidirecionalDirecionado) {
+  construirGrafoSocial(grafo);
+  grafo->inserirVertice("isolado");
+  grafo->removerVertice("v2");
+
+  //ha caminho de o para d (o != d) se e somente se a bfs a partir de o alcanca d
+  for (int o = 0; o < 2001; o += 97) {
+    string origem = string(grafo->getRotulo(o));
+    int* distancias = grafo->bfs(origem);
+
+    for (int d = 0; d < 2001; d += 13) {
+      if (d == o || grafo->estaRemovido(o) || grafo->estaRemovido(d)) continue;
+      EXPECT_EQ(grafo->haCaminho(origem, string(grafo->getRotulo(d))), distancias[d] > 0) << o << " " << d;
+    }
+    free(distancias);
+  }
+
+  //caminho apenas em um sentido
+  grafo->inserirVertice("a");
+  grafo->inserirVertice("b");
+  grafo->inserirArestaDirecionada("a", "b");
+  grafo->inserirArestaDirecionada("b", "v0");
+  EXPECT_TRUE(grafo->haCaminho("a", "v0"));
+  EXPECT_FALSE(grafo->haCaminho("v0", "a"));
+  EXPECT_FALSE(grafo->haCaminho("a", "a"));
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, haCaminhoComInsercoesIntercaladas) {
+  inserirVertices(grafo, 0, 199);
+  unsigned int semente = 7;
+
+  //as consultas enxergam as arestas e os vertices inseridos desde a anterior
+  for (int i = 0; i < 800; i++) {
+    int numVertices = grafo->getNumVertices();
+    semente = semente * 1103515245 + 12345;
+    int a = (semente >> 8) % numVertices;
+    semente = semente * 1103515245 + 12345;
+    int b = (semente >> 8) % numVertices;
+    grafo->inserirArestaDirecionada(string(grafo->getRotulo(a)), string(grafo->getRotulo(b)));
+
+    if (i % 100 == 50) grafo->inserirVertice("n" + to_string(i));
+    if (i == 400) grafo->removerVertice(string(grafo->getRotulo(b)));
+    if (i % 20 != 0 || grafo->estaRemovido(a)) continue;
+
+    string origem = string(grafo->getRotulo(a));
+    int* distancias = grafo->bfs(origem);
+    for (int d = 0; d < grafo->getNumVertices(); d += 7) {
+      if (d == a || grafo->estaRemovido(d)) continue;
+      EXPECT_EQ(grafo->haCaminho(origem, string(grafo->getRotulo(d))), distancias[d] > 0) << i << " " << d;
+    }
+    free(distancias);
+  }
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, componentesConexosIgualColorir) {
+  inserirVertices(grafo, 0, 17);
+  construirGrafoCom5Componentes(grafo);
+
+  int esperados[18], componentes[18];
+  EXPECT_EQ(grafo->colorir(esperados), 5);
+  for (int numThreads = 1; numThreads <= 4; numThreads++) {
+    EXPECT_EQ(grafo->componentesConexos(componentes, numThreads), 5);
+    for (int i = 0; i < 18; i++) EXPECT_EQ(componentes[i], esperados[i]);
+  }
+  EXPECT_EQ(grafo->getRotulo(0), "v0");
+
+  //grafo maior, nao direcionado, com remocoes
+  GrafoListaAdj* maior = new GrafoListaAdj();
+  inserirVertices(maior, 0, 2999);
+  unsigned int semente = 3;
+  for (int i = 0; i < 2500; i++) {
+    semente = semente * 1103515245 + 12345;
+    int a = (semente >> 8) % 3000;
+    semente = semente * 1103515245 + 12345;
+    int b = (semente >> 8) % 3000;
+    maior->inserirArestaNaoDirecionada("v" + to_string(a), "v" + to_string(b));
+  }
+  maior->removerVertice("v10");
+  maior->removerArestaNaoDirecionada("v" + to_string(maior->getVizinhos(0)[0].first), "v0");
+
+  vector<int> esperadosMaior(3000), componentesMaior(3000);
+  int qtde = maior->colorir(esperadosMaior.data());
+  EXPECT_GT(qtde, 1);
+  for (int numThreads = 1; numThreads <= 4; numThreads++) {
+    EXPECT_EQ(maior->componentesConexos(componentesMaior.data(), numThreads), qtde);
+    EXPECT_EQ(componentesMaior, esperadosMaior);
+  }
+  delete (maior);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, componentesConexosDirecionado) {
+  //arestas direcionadas contam nos dois sentidos
+  inserirVertices(grafo, 0, 5);
+  grafo->inserirArestaDirecionada("v0", "v1");
+  grafo->inserirArestaDirecionada("v0", "v2");
+  grafo->inserirArestaDirecionada("v0", "v3");
+  grafo->inserirArestaDirecionada("v4", "v3");
+
+  int componentes[6];
+  EXPECT_EQ(grafo->componentesConexos(componentes, 2), 2);
+  EXPECT_EQ(componentes[4], 1);
+  EXPECT_EQ(componentes[5], 2);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, indiceConectividade) {
+  grafo->ativarIndiceConectividade();
+  inserirVertices(grafo, 0, 5);
+  grafo->inserirArestaNaoDirecionada("v0", "v1");
+
+  //primeira consulta constroi o indice
+  EXPECT_TRUE(grafo->haCaminho("v1", "v0"));
+  EXPECT_FALSE(grafo->haCaminho("v0", "v2"));
+
+  //insercoes posteriores atualizam o indice
+  grafo->inserirArestaNaoDirecionada("v1", "v2");
+  grafo->inserirVertice("v6");
+  grafo->inserirArestaNaoDirecionada("v6", "v3", 4);
+  EXPECT_TRUE(grafo->haCaminho("v0", "v2"));
+  EXPECT_TRUE(grafo->haCaminho("v3", "v6"));
+  EXPECT_FALSE(grafo->haCaminho("v2", "v3"));
+  EXPECT_FALSE(grafo->haCaminho("v0", "v0"));
+
+  //remocoes invalidam o indice, que eh refeito na proxima consulta
+  grafo->removerArestaNaoDirecionada("v1", "v2");
+  EXPECT_FALSE(grafo->haCaminho("v0", "v2"));
+  EXPECT_TRUE(grafo->haCaminho("v0", "v1"));
+  grafo->inserirArestaNaoDirecionada("v2", "v3");
+  grafo->removerVertice("v3");
+  EXPECT_FALSE(grafo->haCaminho("v2", "v6"));
+
+  //com uma aresta direcionada, volta para a busca
+  grafo->inserirArestaDirecionada("v4", "v5");
+  EXPECT_TRUE(grafo->haCaminho("v4", "v5"));
+  EXPECT_FALSE(grafo->haCaminho("v5", "v4"));
+}
+
+/* Grafo de dependencias com n vertices: arestas para vertices
+ * maiores e alguns ciclos curtos.
+ */
+void construirGrafoDependencias(GrafoListaAdj* grafo, int n) {
+  inserirVertices(grafo, 0, n - 1);
+  unsigned int semente = 11;
+  for (int v = 0; v < n; v++) {
+    for (int k = 0; k < 2; k++) {
+      semente = semente * 1103515245 + 12345;
+      int u = v + 1 + (semente >> 8) % 40;
+      if (u < n) grafo->inserirArestaDirecionada("v" + to_string(v), "v" + to_string(u));
+    }
+    if (v % 7 == 3) grafo->inserirArestaDirecionada("v" + to_string(v), "v" + to_string(v - 3));
+  }
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, indiceAlcanceIgualBusca) {
+  int n = 600;
+  construirGrafoDependencias(grafo, n);
+
+  vector<char> esperado;
+  for (int o = 0; o < n; o += 9) {
+    for (int d = 0; d < n; d++) esperado.push_back(grafo->haCaminho("v" + to_string(o), "v" + to_string(d)));
+  }
+
+  grafo->ativarIndiceAlcance();
+  int k = 0;
+  for (int o = 0; o < n; o += 9) {
+    for (int d = 0; d < n; d++, k++) {
+      EXPECT_EQ(grafo->haCaminho("v" + to_string(o), "v" + to_string(d)), esperado[k]) << o << " " << d;
+    }
+  }
+
+  EstatisticasAlcance estatisticas = grafo->getEstatisticasAlcance();
+  EXPECT_LT(estatisticas.numComponentes, n);
+  EXPECT_GT(estatisticas.bytes, 0);
+  EXPECT_EQ(estatisticas.consultasPorRotulos + estatisticas.consultasComBusca, k - n / 9 - 1);
+
+  //modificacoes invalidam o indice
+  EXPECT_FALSE(grafo->haCaminho("v599", "v0"));
+  grafo->inserirArestaDirecionada("v599", "v0");
+  EXPECT_TRUE(grafo->haCaminho("v599", "v0"));
+  EXPECT_LT(grafo->getEstatisticasAlcance().numComponentes, estatisticas.numComponentes);
+
+  //v599 so tem a aresta para v0: alcanca o mesmo que v0
+  for (int d = 1; d < n - 1; d++) {
+    EXPECT_EQ(grafo->haCaminho("v599", "v" + to_string(d)), grafo->haCaminho("v0", "v" + to_string(d))) << d;
+  }
+
+  grafo->removerAresta("v599", "v0");
+  EXPECT_FALSE(grafo->haCaminho("v599", "v0"));
+  EXPECT_EQ(grafo->getEstatisticasAlcance().numComponentes, estatisticas.numComponentes);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, componentesFortes) {
+  //{v0, v1, v2} -> {v3, v4} -> v5, e v6 isolado
+  inserirVertices(grafo, 0, 7);
+  grafo->inserirArestaDirecionada("v0", "v1");
+  grafo->inserirArestaDirecionada("v1", "v2");
+  grafo->inserirArestaDirecionada("v2", "v0");
+  grafo->inserirArestaDirecionada("v2", "v3");
+  grafo->inserirArestaDirecionada("v1", "v4");
+  grafo->inserirArestaDirecionada("v3", "v4");
+  grafo->inserirArestaDirecionada("v4", "v3");
+  grafo->inserirArestaDirecionada("v4", "v5");
+  grafo->removerVertice("v7");
+
+  int componentes[8];
+  CondensacaoGrafo condensacao;
+  EXPECT_EQ(grafo->componentesFortes(componentes, condensacao), 4);
+  EXPECT_EQ(componentes[0], componentes[1]);
+  EXPECT_EQ(componentes[0], componentes[2]);
+  EXPECT_EQ(componentes[3], componentes[4]);
+  EXPECT_NE(componentes[0], componentes[3]);
+  EXPECT_EQ(componentes[7], -1);
+
+  //ordem topologica reversa
+  EXPECT_GT(componentes[0], componentes[3]);
+  EXPECT_GT(componentes[3], componentes[5]);
+
+  //arestas repetidas entre componentes aparecem uma vez
+  EXPECT_EQ(condensacao.numComponentes, 4);
+  EXPECT_EQ(condensacao.offsets[4], 2);
+  int a = componentes[0];
+  ASSERT_EQ(condensacao.offsets[a + 1] - condensacao.offsets[a], 1);
+  EXPECT_EQ(condensacao.destinos[condensacao.offsets[a]], componentes[3]);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, componentesFortesIgualAlcanceMutuo) {
+  int n = 600;
+  construirGrafoDependencias(grafo, n);
+  grafo->removerVertice("v5");
+
+  vector<int> componentes(n);
+  CondensacaoGrafo condensacao;
+  EXPECT_GT(grafo->componentesFortes(componentes.data(), condensacao), 1);
+
+  for (int o = 0; o < n; o += 7) {
+    for (int d = o - 30; d < o + 30; d++) {
+      if (d < 0 || d >= n) continue;
+      if (o == d || o == 5 || d == 5) continue;
+      string vo = "v" + to_string(o), vd = "v" + to_string(d);
+      bool mutuo = grafo->haCaminho(vo, vd) && grafo->haCaminho(vd, vo);
+      EXPECT_EQ(componentes[o] == componentes[d], mutuo) << o << " " << d;
+    }
+  }
+
+  for (int c = 0; c < condensacao.numComponentes; c++) {
+    for (int k = condensacao.offsets[c]; k < condensacao.offsets[c + 1]; k++) EXPECT_LT(condensacao.destinos[k], c);
+  }
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, componentesFortesCicloLongo) {
+  //sem recursao: um ciclo de 300000 vertices eh um unico componente
+  int n = 300000;
+  inserirVertices(grafo, 0, n - 1);
+  for (int i = 0; i < n; i++) grafo->inserirArestaDirecionada("v" + to_string(i), "v" + to_string((i + 1) % n));
+
+  vector<int> componentes(n);
+  EXPECT_EQ(grafo->componentesFortes(componentes.data()), 1);
+  EXPECT_EQ(componentes[n - 1], 0);
+
+  grafo->removerAresta("v" + to_string(n - 1), "v0");
+  EXPECT_EQ(grafo->componentesFortes(componentes.data()), n);
+  EXPECT_EQ(componentes[0], n - 1);
+}
+
+/* Funcao auxiliar que verifica se nenhuma aresta liga dois
+ * vertices da mesma cor.
+ */
+void expectColoracaoPropria(GrafoListaAdj* grafo, int* cores) {
+  for (int v = 0; v < grafo->getNumVertices(); v++) {
+    for (const pair<int, int>& aresta : grafo->getVizinhos(v)) {
+      if (aresta.first != ARESTA_REMOVIDA && aresta.first != v) {
+        EXPECT_NE(cores[v], cores[aresta.first]) << v;
+      }
+    }
+  }
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, colorirVerticesColoracaoPropria) {
+  construirGrafoSocial(grafo);
+  grafo->removerVertice("v3");
+  int n = grafo->getNumVertices();
+  vector<int> cores(n);
+
+  OrdemColoracao ordens[] = {ORDEM_NATURAL, ORDEM_MAIOR_GRAU, ORDEM_MENOR_ULTIMO};
+  for (OrdemColoracao ordem : ordens) {
+    for (int numThreads = 1; numThreads <= 4; numThreads *= 2) {
+      EstatisticasColoracao estatisticas;
+      int numCores = grafo->colorirVertices(cores.data(), numThreads, ordem, &estatisticas);
+
+      expectColoracaoPropria(grafo, cores.data());
+      EXPECT_EQ(cores[3], -1);
+      EXPECT_EQ(count(cores.begin(), cores.end(), -1), 1);
+      EXPECT_EQ(estatisticas.numCores, numCores);
+      EXPECT_EQ(*max_element(cores.begin(), cores.end()), numCores - 1);
+      if (numThreads == 1) {
+        EXPECT_EQ(estatisticas.rodadas, 1);
+      }
+    }
+  }
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, colorirVerticesQuantidadeDeCores) {
+  //caminho v0 - v1 - ... - v5 com v6 ligado em todos:
+  //degeneracao 2, entao smallest-last usa 3 cores
+  inserirVertices(grafo, 0, 6);
+  for (int i = 0; i < 5; i++) grafo->inserirArestaNaoDirecionada("v" + to_string(i), "v" + to_string(i + 1));
+  for (int i = 0; i < 6; i++) grafo->inserirArestaDirecionada("v6", "v" + to_string(i));
+
+  int cores[7];
+  EXPECT_EQ(grafo->colorirVertices(cores, 1, ORDEM_MENOR_ULTIMO), 3);
+  EXPECT_EQ(grafo->colorirVertices(cores, 2, ORDEM_MAIOR_GRAU), 3);
+  EXPECT_EQ(cores[6], 0);
+
+  //K5
+  for (int i = 0; i < 5; i++) {
+    for (int j = i + 2; j < 5; j++) grafo->inserirArestaNaoDirecionada("v" + to_string(i), "v" + to_string(j));
+  }
+  EXPECT_EQ(grafo->colorirVertices(cores, 2), 6);
+  expectColoracaoPropria(grafo, cores);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, espacoBuscaReaproveitado) {
+  construirGrafoSocial(grafo);
+  grafo->inserirVertice("isolado");
+  int n = grafo->getNumVertices();
+  EspacoBusca espaco;
+
+  for (int o = 0; o < n - 1; o += 250) {
+    string origem = "v" + to_string(o);
+    int* esperadas = grafo->bfs(origem);
+    int alcancados = grafo->bfs(origem, espaco);
+
+    EXPECT_EQ(espaco.fila[0], o);
+    for (int v = 0; v < n; v++) {
+      if (espaco.visitado(v))
+        EXPECT_EQ(espaco.distancias[v], esperadas[v]) << origem << " " << v;
+      else
+        EXPECT_EQ(esperadas[v], 0);
+    }
+    EXPECT_FALSE(espaco.visitado(n - 1));
+    EXPECT_EQ(alcancados, n - 1);
+    free(esperadas);
+  }
+
+  //consultas seguintes nao alocam
+  size_t capacidadeFila = espaco.fila.capacity();
+  size_t capacidadeMarcas = espaco.marcas.capacity();
+  EXPECT_TRUE(grafo->haCaminho("v3", "v1999", espaco));
+  EXPECT_FALSE(grafo->haCaminho("v3", "isolado", espaco));
+  EXPECT_EQ(grafo->bfs("isolado", espaco), 1);
+  EXPECT_EQ(grafo->bfs("inexistente", espaco), -1);
+  EXPECT_EQ(grafo->bfs("inexistente"), (int*)NULL);
+  vector<int> componentes(n);
+  EXPECT_EQ(grafo->colorir(componentes.data(), espaco), 2);
+  EXPECT_EQ(componentes[n - 1], 2);
+  EXPECT_EQ(espaco.fila.capacity(), capacidadeFila);
+  EXPECT_EQ(espaco.marcas.capacity(), capacidadeMarcas);
+
+  //a geracao pode dar a volta sem confundir marcas antigas
+  espaco.geracao = UINT_MAX - 1;
+  EXPECT_EQ(grafo->bfs("v0", espaco), n - 1);
+  EXPECT_EQ(grafo->bfs("isolado", espaco), 1);
+  EXPECT_EQ(espaco.geracao, 1);
+  EXPECT_FALSE(espaco.visitado(0));
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, bfsComPredecessores) {
+  construirGrafoSocial(grafo);
+  grafo->inserirVertice("isolado");
+  int n = grafo->getNumVertices();
+
+  vector<int> predecessores(n), caminho(n);
+  int* distancias = grafo->bfs("v17", predecessores.data());
+
+  EXPECT_EQ(predecessores[17], 17);
+  EXPECT_EQ(GrafoListaAdj::reconstruirCaminho(predecessores.data(), n - 1, caminho.data()), -1);
+  for (int v = 0; v < n - 1; v++) {
+    int tamanho = GrafoListaAdj::reconstruirCaminho(predecessores.data(), v, caminho.data());
+    ASSERT_EQ(tamanho, distancias[v] + 1) << v;
+    EXPECT_EQ(caminho[0], 17);
+    EXPECT_EQ(caminho[tamanho - 1], v);
+    for (int i = 1; i < tamanho; i++) {
+      EXPECT_TRUE(grafo->saoConectados(string(grafo->getRotulo(caminho[i - 1])), string(grafo->getRotulo(caminho[i]))));
+    }
+  }
+  free(distancias);
+
+  EspacoBusca espaco;
+  grafo->bfs("v17", espaco);
+  EXPECT_EQ(espaco.caminhoAte(1999, caminho.data()), espaco.distancias[1999] + 1);
+  EXPECT_EQ(espaco.caminhoAte(n - 1, caminho.data()), -1);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, percursoBfsPreguicoso) {
+  construirGrafoSocial(grafo);
+  int n = grafo->getNumVertices();
+  int* esperadas = grafo->bfs("v1000");
+
+  //todos os vertices, em ordem de distancia
+  EspacoBusca espaco;
+  int anterior = 0, lidos = 0;
+  for (VerticeAlcancado alcancado : grafo->percorrer("v1000", PERCURSO_BFS, espaco)) {
+    EXPECT_EQ(alcancado.distancia, esperadas[alcancado.vertice]);
+    EXPECT_GE(alcancado.distancia, anterior);
+    anterior = alcancado.distancia;
+    lidos++;
+  }
+  EXPECT_EQ(lidos, n);
+  free(esperadas);
+
+  //parar cedo: so os vizinhos dos vertices lidos foram examinados
+  GrafoListaAdj::Percurso percurso = grafo->percorrer("v1000", PERCURSO_BFS, espaco);
+  EXPECT_EQ(percurso.getAtual().vertice, 1000);
+  for (int k = 0; k < 3; k++) EXPECT_TRUE(percurso.avancar());
+  EXPECT_LT(percurso.getEspaco().fila.size(), n / 10);
+
+  EXPECT_TRUE(grafo->percorrer("inexistente", PERCURSO_BFS).fim());
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, percursoDfsPreOrdem) {
+  inserirVertices(grafo, 1, 9);
+  construirGrafoNaoPonderado(grafo);
+
+  vector<int> ordem, profundidades;
+  for (VerticeAlcancado alcancado : grafo->percorrer("v1", PERCURSO_DFS)) {
+    ordem.push_back(alcancado.vertice);
+    profundidades.push_back(alcancado.distancia);
+  }
+
+  //mesma ordem de dfs: v1 v2 v4 v3 v5 v9 v8 v6 v7
+  vector<int> ordemEsperada = {0, 1, 3, 2, 4, 8, 7, 5, 6};
+  vector<int> profundidadesEsperadas = {0, 1, 2, 3, 4, 5, 6, 7, 3};
+  EXPECT_EQ(ordem, ordemEsperada);
+  EXPECT_EQ(profundidades, profundidadesEsperadas);
+
+  //parar ao encontrar v5
+  int lidos = 0;
+  for (const VerticeAlcancado& alcancado : grafo->percorrer("v1", PERCURSO_DFS)) {
+    lidos++;
+    if (alcancado.vertice == 4) break;
+  }
+  EXPECT_EQ(lidos, 5);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, percursoDijkstra) {
+  inserirVertices(grafo, 1, 10);
+  grafo->inserirArestaNaoDirecionada("v1", "v2", 6);
+  grafo->inserirArestaNaoDirecionada("v1", "v3", 4);
+  grafo->inserirArestaNaoDirecionada("v2", "v4", 5);
+  grafo->inserirArestaNaoDirecionada("v3", "v4", 2);
+  grafo->inserirArestaNaoDirecionada("v3", "v5", 4);
+  grafo->inserirArestaNaoDirecionada("v4", "v6", 5);
+  grafo->inserirArestaNaoDirecionada("v4", "v7", 5);
+  grafo->inserirArestaNaoDirecionada("v5", "v9", 9);
+  grafo->inserirArestaNaoDirecionada("v6", "v8", 6);
+  grafo->inserirArestaNaoDirecionada("v8", "v9", 8);
+
+  int esperadas[] = {0, 6, 4, 6, 8, 11, 11, 17, 17};
+  vector<bool> vistos(10, false);
+  int anterior = 0, lidos = 0;
+
+  EspacoBusca espaco;
+  GrafoListaAdj::Percurso percurso = grafo->percorrer("v1", PERCURSO_DIJKSTRA, espaco);
+  for (VerticeAlcancado alcancado : percurso) {
+    EXPECT_FALSE(vistos[alcancado.vertice]);
+    vistos[alcancado.vertice] = true;
+    EXPECT_EQ(alcancado.distancia, esperadas[alcancado.vertice]);
+    EXPECT_GE(alcancado.distancia, anterior);
+    anterior = alcancado.distancia;
+    lidos++;
+  }
+  EXPECT_EQ(lidos, 9);
+  EXPECT_FALSE(vistos[9]);
+  EXPECT_TRUE(percurso.fim());
+
+  //v1 -> v3 -> v5 -> v9
+  int caminho[10];
+  EXPECT_EQ(espaco.caminhoAte(8, caminho), 4);
+  EXPECT_EQ(caminho[2], 4);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, vizinhancaKHopsIgualBfs) {
+  construirGrafoSocial(grafo);
+  int n = grafo->getNumVertices();
+  EspacoBusca espaco;
+
+  for (int o = 0; o < n; o += 333) {
+    string origem = "v" + to_string(o);
+    int* distancias = grafo->bfs(origem);
+
+    for (int k = 0; k <= 3; k++) {
+      int esperados = 0;
+      for (int v = 0; v < n; v++) {
+        if ((v == o || distancias[v] > 0) && distancias[v] <= k) esperados++;
+      }
+
+      EXPECT_EQ(grafo->vizinhancaKHops(origem, k, espaco), esperados) << origem << " " << k;
+      for (int v : espaco.fila) EXPECT_EQ(espaco.distancias[v], distancias[v]);
+    }
+    free(distancias);
+  }
+
+  vector<int> vizinhanca = grafo->vizinhancaKHops("v0", 0);
+  EXPECT_EQ(vizinhanca.size(), 1);
+  EXPECT_TRUE(grafo->vizinhancaKHops("inexistente", 2).empty());
+  EXPECT_EQ(grafo->vizinhancaKHops("v0", -1, espaco), -1);
+}
+
+TEST_F(GrafoListaAdjNavegacaoTest, vizinhancasKHopsEmLote) {
+  construirGrafoSocial(grafo);
+  vector<string> origens = {"v5", "v1999", "v42", "v5", "v700"};
+
+  for (int numThreads = 1; numThreads <= 3; numThreads += 2) {
+    Vizinhancas resultado;
+    int total = grafo->vizinhancasKHops(origens, 2, resultado, numThreads);
+    ASSERT_EQ(resultado.offsets.size(), origens.size() + 1);
+    EXPECT_EQ(resultado.offsets.back(), total);
+
+    for (int i = 0; i < origens.size(); i++) {
+      vector<int> esperada = grafo->vizinhancaKHops(origens[i], 2);
+      vector<int> vizinhanca(resultado.vertices.begin() + resultado.offsets[i],
+                             resultado.vertices.begin() + resultado.offsets[i + 1]);
+      EXPECT_EQ(vizinhanca, esperada) << origens[i];
+      EXPECT_EQ(resultado.distancias[resultado.offsets[i]], 0);
+      EXPECT_EQ(resultado.distancias[resultado.offsets[i + 1] - 1], 2);
+    }
+  }
+
+  Vizinhancas resultado;
+  origens.push_back("inexistente");
+  EXPECT_EQ(grafo->vizinhancasKHops(origens, 2, resultado), -1);
+  EXPECT_TRUE(resultado.offsets.empty());
+}
@@ -0,0 +1,142 @@
+#include "../src/grafos/grafoSnapshot.h"
+#include "pch.h"
+using namespace std;
+
+class GrafoSnapshotTest : public ::testing::Test {
+ protected:
+  virtual void TearDown() {
+    delete (grafo);
+  }
+
+  virtual void SetUp() {
+    grafo = new GrafoVersionado();
+  }
+
+  GrafoVersionado* grafo;
+};
+
+/* Funcao auxiliar para adicionar vertices em uma sequencia.
+ * Sao adicionados no seguinte formato: "v1", "v2", ...
+ */
+void inserirVertices(GrafoVersionado* grafo, int ini, int fim) {
+  for (int i = ini; i <= fim; i++) grafo->inserirVertice("v" + to_string(i));
+}
+
+TEST_F(GrafoSnapshotTest, SnapshotNaoVeAlteracoesPosteriores) {
+  inserirVertices(grafo, 1, 4);
+  grafo->inserirArestaNaoDirecionada("v1", "v2", 5);
+  grafo->inserirArestaNaoDirecionada("v2", "v3", 5);
+  EXPECT_EQ(grafo->publicar(), 1);
+
+  int leitor = grafo->registrarLeitor();
+  ASSERT_NE(leitor, -1);
+  {
+    SnapshotGrafo antigo = grafo->fixar(leitor);
+
+    //alteracoes so aparecem depois de publicar
+    grafo->inserirArestaDirecionada("v1", "v3", 1);
+    grafo->removerArestaNaoDirecionada("v1", "v2");
+    grafo->inserirArestaDirecionada("v3", "v4", 1);
+    EXPECT_EQ(grafo->getGeracaoAtual(), 1);
+    EXPECT_TRUE(antigo.saoConectados("v1", "v2"));
+
+    EXPECT_EQ(grafo->publicar(), 2);
+    EXPECT_EQ(antigo.getGeracao(), 1);
+    EXPECT_TRUE(antigo.saoConectados("v1", "v2"));
+    EXPECT_FALSE(antigo.haCaminho("v1", "v4"));
+
+    int* distancias = antigo.dijkstra("v1");
+    EXPECT_EQ(distancias[2], 10);
+    free(distancias);
+
+    //a geracao 1 continua fixada
+    EXPECT_EQ(grafo->getQtdeGeracoesPendentes(), 1);
+  }
+  EXPECT_EQ(grafo->getQtdeGeracoesPendentes(), 0);
+
+  SnapshotGrafo novo = grafo->fixar(leitor);
+  EXPECT_EQ(novo.getGeracao(), 2);
+  EXPECT_FALSE(novo.saoConectados("v1", "v2"));
+  EXPECT_FALSE(novo.saoConectados("v2", "v1"));
+  EXPECT_TRUE(novo.saoConectados("v3", "v2"));
+  EXPECT_TRUE(novo.haCaminho("v1", "v4"));
+  EXPECT_FALSE(novo.haCaminho("v1", "v1"));
+  EXPECT_FALSE(novo.haCaminho("v4", "v1"));
+
+  int* distancias = novo.dijkstra("v1");
+  EXPECT_EQ(distancias[2], 1);
+  EXPECT_EQ(distancias[1], 6);
+  free(distancias);
+}
+
+TEST_F(GrafoSnapshotTest, RemocaoAfetaApenasArestasAnteriores) {
+  inserirVertices(grafo, 1, 2);
+  grafo->inserirArestaDirecionada("v1", "v2", 1);
+  grafo->inserirArestaDirecionada("v1", "v2", 2);
+  grafo->removerAresta("v1", "v2");
+  grafo->inserirArestaDirecionada("v1", "v2", 3);
+  grafo->inserirArestaDirecionada("v1", "v9", 3);  //v9 nao existe
+  grafo->publicar();
+
+  int leitor = grafo->registrarLeitor();
+  SnapshotGrafo snapshot = grafo->fixar(leitor);
+  EXPECT_EQ(snapshot.getGrafo()->numArestas(), 1);
+  EXPECT_EQ(snapshot.getGrafo()->getPesos()[0], 3);
+}
+
+TEST_F(GrafoSnapshotTest, HaCaminhoParaSiMesmoSoComLaco) {
+  inserirVertices(grafo, 1, 3);
+  grafo->inserirArestaNaoDirecionada("v1", "v2", 1);
+  grafo->inserirArestaDirecionada("v3", "v3", 1);
+  grafo->publicar();
+
+  int leitor = grafo->registrarLeitor();
+  SnapshotGrafo snapshot = grafo->fixar(leitor);
+
+  //v1 -> v2 -> v1 eh um ciclo, mas nao um laco
+  EXPECT_TRUE(snapshot.haCaminho("v1", "v2"));
+  EXPECT_FALSE(snapshot.haCaminho("v1", "v1"));
+  EXPECT_FALSE(snapshot.haCaminho("v2", "v2"));
+  EXPECT_TRUE(snapshot.haCaminho("v3", "v3"));
+}
+
+TEST_F(GrafoSnapshotTest, LeitoresConcorrentesDuranteAtualizacoes) {
+  //cada geracao eh um caminho v0 - v1 - ... - vN, com N crescendo
+  inserirVertices(grafo, 0, 1);
+  grafo->inserirArestaNaoDirecionada("v0", "v1", 1);
+  grafo->publicar();
+
+  atomic<bool> fim(false);
+  atomic<int> erros(0);
+  vector<thread> leitores;
+
+  for (int t = 0; t < 3; t++) {
+    leitores.emplace_back([&]() {
+      int leitor = grafo->registrarLeitor();
+      while (!fim.load()) {
+        SnapshotGrafo snapshot = grafo->fixar(leitor);
+        int ultimo = snapshot.getGrafo()->numVertices() - 1;
+
+        int* distancias = snapshot.dijkstra("v0");
+        if (distancias[ultimo] != ultimo) erros++;
+        free(distancias);
+
+        if (!snapshot.haCaminho("v" + to_string(ultimo), "v0")) erros++;
+      }
+      grafo->desregistrarLeitor(leitor);
+    });
+  }
+
+  for (int n = 2; n <= 60; n++) {
+    grafo->inserirVertice("v" + to_string(n));
+    grafo->inserirArestaNaoDirecionada("v" + to_string(n - 1), "v" + to_string(n), 1);
+    grafo->publicar();
+  }
+
+  fim.store(true);
+  for (thread& leitor : leitores) leitor.join();
+
+  EXPECT_EQ(erros.load(), 0);
+  EXPECT_EQ(grafo->getGeracaoAtual(), 60);
+  EXPECT_EQ(grafo->getQtdeGeracoesPendentes(), 0);
+}